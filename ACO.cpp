@@ -10,7 +10,8 @@
 #include "tasks/keytasks.h"
 #define debug(i) std::cout <<"line= "<<__LINE__<<" , "<<#i<<" = "<< i << std::endl;
 
-ACO::ACO(int _SwarmSize, double _InitialPhereomone,double _q0, double _beta,double _evaporationRate,std::map<std::string,Task*> _Map, int _nbWorkers,int _lag)
+ACO::ACO(int _SwarmSize, double _InitialPhereomone,double _q0, double _beta,double _evaporationRate,std::map<std::string,Task*> _Map, int _nbWorkers,int _lag, SequenceState& _state)
+: m_state(_state)
 {
    
     m_swarm=new Swarm;
@@ -21,6 +22,8 @@ ACO::ACO(int _SwarmSize, double _InitialPhereomone,double _q0, double _beta,doub
     {
         Ant* ant=new Ant;
         ant->id=i;
+        ant->visitedNodes.assign(_Map.size(),0);
+        ant->nbVisited=0;
         ant->makespan=0.0;
         if(i==0)
         {
@@ -38,25 +41,39 @@ ACO::ACO(int _SwarmSize, double _InitialPhereomone,double _q0, double _beta,doub
     m_beta=_beta;
     m_evaporationRate=_evaporationRate;
     m_Map=_Map;
+    m_Pheromone.assign(m_Map.size()*m_Map.size(),0.0);
     m_wave=0;
-    sequence.GetTaskMap()=m_Map;
     m_lag=_lag;
 };
 void ACO::UpdatePheremone(Task* _task,Task* _nextTask)
 {
-    std::pair<Task*,Task*> key=std::make_pair(_task,_nextTask);
+    size_t key=PheromoneIndex(_task,_nextTask);
     m_Pheromone[key]=(1-m_evaporationRate)*m_Pheromone[key]+m_evaporationRate*m_InitialPhereomone;
 };
 
+// The rank of a task is the number of tasks visited before it, plus one
+void ACO::Visit(Ant* ant,Task* _task)
+{
+    int& rank=ant->visitedNodes[_task->GetIndex()];
+    if(rank==0)
+    {
+        rank=++ant->nbVisited;
+    }
+    else
+    {
+        rank=ant->nbVisited+1;
+    }
+};
+
 std::vector<Task*> ACO::ReadyTasks(Task* _StartTask,Ant* ant)
 {
     std::vector<Task*> vec;
     for(auto elem:m_Map)
     {
-        if(elem.second->GetTaskType()=="engine")
+        if(elem.second->GetTaskType()==TaskType::ENGINE)
         {
             bool IsIn=false;
-            if(ant->visitedNodes.count(elem.second)==0)
+            if(!IsVisited(ant,elem.second))
             {
                 IsIn = true;
             }
@@ -65,9 +82,9 @@ std::vector<Task*> ACO::ReadyTasks(Task* _StartTask,Ant* ant)
             {
                 for(auto father:elem.second->GetFathers())
                 {
-                    if(father->GetTaskType()=="engine")
+                    if(father->GetTaskType()==TaskType::ENGINE)
                     {
-                        if(ant->visitedNodes.count(father)==0)
+                        if(!IsVisited(ant,father))
                         {
                             found = false;
                         }
@@ -103,91 +120,57 @@ Task* ACO::GetNextTask(Task* _StartTask,Ant* ant)
     if(q<m_q0)
     {
         Task* task=nullptr;
-        std::map<Task*,double> TaskValue;
-        for(auto elem: ReadyTask)
-        {
-            TaskValue[elem]=this->TaskDecisonValue(_StartTask,elem);
-           
-        }
-        
         double max=0.0;
-        for(auto elem:TaskValue)
+        for(auto elem: ReadyTask)
         {
-            if(max<elem.second)
+            double value=this->TaskDecisonValue(_StartTask,elem);
+            if(max<value)
             {
-                max=elem.second;
-                task=elem.first;
+                max=value;
+                task=elem;
             }
         }
-      
-        int size=ant->visitedNodes.size();
-        
-        ant->visitedNodes[task]=size+1;
-    
-        UpdatePheremone(_StartTask,task);
-        std::pair<Task*,Task*> key=std::make_pair(_StartTask,task);
-       
-        return task;
-    }
-    else
-    {
-        double norme=0.0;
-        std::map<Task*,double> TaskProbability;
-       
-     
-      
-        for(auto elem: ReadyTask)
+
+        // Without any positive decision value, the task is drawn as below
+        if(task!=nullptr)
         {
-            
-            if(std::isnan(this->TaskDecisonValue(_StartTask,elem)))
-            {
-                TaskProbability[elem]=pow(10,-5);
-                
-            }
-            else
-            {
-                TaskProbability[elem]=this->TaskDecisonValue(_StartTask,elem);
-                
-            }
-                
-         
-            
+            Visit(ant,task);
+            UpdatePheremone(_StartTask,task);
+            return task;
         }
-        
-        std::vector<Task*> TaskCluster;
-       
-        
-        double* min=new double;
-        *min=std::numeric_limits<double>().max();
-        for(auto elem:TaskProbability)
+    }
+
+    std::vector<double> TaskProbability;
+    for(auto elem: ReadyTask)
+    {
+        double value=this->TaskDecisonValue(_StartTask,elem);
+        TaskProbability.push_back(std::isnan(value)? pow(10,-5):value);
+    }
+
+    std::vector<Task*> TaskCluster;
+    double min=std::numeric_limits<double>().max();
+    for(auto elem:TaskProbability)
+    {
+        if(elem<min)
         {
-            if(elem.second<*min)
-            {
-                *min=elem.second;
-            }       
+            min=elem;
         }
-        
-        for(auto elem:TaskProbability)
+    }
+
+    for(size_t j=0;j<ReadyTask.size();j++)
+    {
+        for(int i=0;i<std::ceil(TaskProbability[j]/min);i++)
         {
-            for(int i=0;i<std::ceil(elem.second/(*min));i++)
-            {
-                TaskCluster.push_back(elem.first);
-            }
+            TaskCluster.push_back(ReadyTask[j]);
         }
-        srand(time(0));
-        Task* task=nullptr;
-       
-        task=TaskCluster[rand()%TaskCluster.size()];
-       
-        int size=ant->visitedNodes.size();
-     
-        ant->visitedNodes[task]=size+1;
-       
-        UpdatePheremone(_StartTask,task);
-        std::pair<Task*,Task*> key=std::make_pair(_StartTask,task);
-       
-        return task;
     }
+    srand(time(0));
+    Task* task=TaskCluster[rand()%TaskCluster.size()];
+
+    Visit(ant,task);
+    UpdatePheremone(_StartTask,task);
+
+    return task;
 };
 
 
@@ -212,7 +195,7 @@ void ACO::QueenStroll(Ant* ant)
     task=m_Map[INIT_TASK];
    bool stop=true;
    
-    while(ant->visitedNodes.count(m_Map[END_TASK])==0&&stop)
+    while(!IsVisited(ant,m_Map[END_TASK])&&stop)
     {
         std::vector<Task*> ReadyTask=ReadyTasks(task,ant);
         
@@ -241,11 +224,8 @@ void ACO::QueenStroll(Ant* ant)
         
         if(task!=nullptr)
         {
-            int size=ant->visitedNodes.size();
-        
-            ant->visitedNodes[task]=size+1;   
-        }
-          
+            Visit(ant,task);
+        }          
     } 
 }
 void ACO::WorkSwarm()
@@ -270,11 +250,11 @@ void ACO::WorkSwarm()
       
        for(auto elem:m_Map)
 			{
-				elem.second->AddAnt(ant->visitedNodes[elem.second]);
+				m_state.GetState(elem.second)->AddAnt(ant->visitedNodes[elem.second->GetIndex()]);
 		
 			}
             TimeCurrent = dev->GetGlobalClockTime();
-            dev->PlaySequence(sequence,m_lag);
+            dev->PlaySequence(m_state,m_lag);
             TimePrevious = TimeCurrent;
             ant->makespan=dev->GetGlobalClockTime()- TimePrevious;
             
@@ -284,7 +264,7 @@ void ACO::WorkSwarm()
  
 };
 
-std::map<Task*,int> ACO::GetBestScheduling()
+std::vector<int> ACO::GetBestScheduling()
 {
  
     this->WorkSwarm();
@@ -308,7 +288,5 @@ std::map<Task*,int> ACO::GetBestScheduling()
   
     this->AddLuckyAnt(LuckyAnt);
    
-    std::map<Task*,int> visitedNode=LuckyAnt->visitedNodes;
-
     return LuckyAnt->visitedNodes;
 };
\ No newline at end of file
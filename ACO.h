@@ -18,7 +18,8 @@ enum Rank
 struct Ant
 {
     int id;
-    std::map<Task*,int> visitedNodes;
+    std::vector<int> visitedNodes; // visit rank of each task by index, 0 if not visited
+    int nbVisited;
     double makespan;
     Rank rank;
 };
@@ -31,25 +32,27 @@ struct Swarm
 class ACO
 {
     public:
-    ACO(int _SwarmSize, double _InitialPhereomone,double _q0, double _beta,double _evaporationRate,std::map<std::string,Task*> _Map, int _nbWorkers,int _lag);
+    ACO(int _SwarmSize, double _InitialPhereomone,double _q0, double _beta,double _evaporationRate,std::map<std::string,Task*> _Map, int _nbWorkers,int _lag, SequenceState& _state);
     
-    double Pheremone(Task* _task,Task* _nextTask){ return (m_Pheromone[std::make_pair(_task,_nextTask)]==0.0)? m_InitialPhereomone:m_Pheromone[std::make_pair(_task,_nextTask)];};
+    double Pheremone(Task* _task,Task* _nextTask){ double pheromone=m_Pheromone[PheromoneIndex(_task,_nextTask)]; return (pheromone==0.0)? m_InitialPhereomone:pheromone;};
     void UpdatePheremone(Task* _task,Task* _nextTask);
-    double PassageQuality(Task* _nextTask){return 1.0/_nextTask->GetResponseRatio();};//1.0/(_nextTask->GetPT()+1.0)
+    double PassageQuality(Task* _nextTask){return 1.0/m_state.GetState(_nextTask)->GetResponseRatio();};//1.0/(_nextTask->GetPT()+1.0)
     std::vector<Task*> ReadyTasks(Task* _StartTask,Ant* ant);
     double TaskDecisonValue(Task* _task,Task* _nextTask){ return Pheremone(_task,_nextTask)*pow(PassageQuality(_nextTask),m_beta); };
     Task* GetNextTask(Task* _StartTask,Ant* ant);
     void WorkAnt(Ant* ant);
     void QueenStroll(Ant* ant);
-    std::map<Task*,int> GetAntPath(Ant* ant){return ant->visitedNodes;};
+    std::vector<int> GetAntPath(Ant* ant){return ant->visitedNodes;};
     int GetNextPosition(Ant* ant);
     void WorkSwarm();
-    std::map<Task*,int> GetBestScheduling();
+    std::vector<int> GetBestScheduling();
     void AddLuckyAnt(Ant* _Ant){m_LuckyAnt=_Ant;};
     Ant* GetLuckyAnt(){return m_LuckyAnt;}
     private:
-    std::map<Task*,bool> m_IsVisited;
-    std::map<std::pair<Task*,Task*>,double> m_Pheromone;
+    size_t PheromoneIndex(Task* _task,Task* _nextTask){ return _task->GetIndex()*m_Map.size()+_nextTask->GetIndex(); };
+    void Visit(Ant* ant,Task* _task);
+    bool IsVisited(Ant* ant,Task* _task){ return ant->visitedNodes[_task->GetIndex()]!=0; };
+    std::vector<double> m_Pheromone; // pheromone of each edge, by task index of both ends
     std::map<std::string,Task*> m_Map;
     double m_InitialPhereomone;
     double m_q0;
@@ -59,6 +62,6 @@ class ACO
     Swarm* m_swarm;
     Ant* m_LuckyAnt;
     int m_wave;
-    TaskSequence sequence;
+    SequenceState m_state; // the ants play the frame on their own copy of the simulation state
     int m_lag;
 };
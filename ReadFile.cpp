@@ -13,7 +13,7 @@ using namespace std;
 
 
 Readfile::Readfile(std::string file_name)
-: file_name_(file_name),  if_nbFrame(false), if_nbWorkers(false), if_nbStartSeed(false), if_nbEndSeed(false), if_mode(false), if_IsDivided(false)
+: file_name_(file_name), _StreamFrames(0), _RacingSeeds(0), _AdaptiveFrameWidth(0.0), _AdaptiveDelayedWidth(0.0), _ImportanceShift(0.0), _SteadyStateWidth(0.0), _Sampling("Plain"), _CounterRng(false), _BoundsOutput(false), if_nbFrame(false), if_nbWorkers(false), if_nbStartSeed(false), if_nbEndSeed(false), if_mode(false), if_IsDivided(false), if_CounterRng(false), if_SampleCache(false), if_StreamFrames(false), if_BoundsOutput(false), if_RacingSeeds(false), if_AdaptiveWidth(false), if_Sampling(false), if_ImportanceShift(false), if_SteadyState(false)
 {
 }
 
@@ -98,6 +98,51 @@ void Readfile::Read_data_file()
             data_file >> _SortingSteps;
             if_JsonOutput= true;
         }
+        if (file_line.find("_CounterRng") != std::string::npos)
+        {
+            data_file >> _CounterRng;
+            if_CounterRng= true;
+        }
+        if (file_line.find("_ImportanceShift") != std::string::npos)
+        {
+            data_file >> _ImportanceShift;
+            if_ImportanceShift= true;
+        }
+        if (file_line.find("_Sampling") != std::string::npos)
+        {
+            data_file >> _Sampling;
+            if_Sampling= true;
+        }
+        if (file_line.find("_SampleCache") != std::string::npos)
+        {
+            data_file >> _SampleCache;
+            if_SampleCache= true;
+        }
+        if (file_line.find("_StreamFrames") != std::string::npos)
+        {
+            data_file >> _StreamFrames;
+            if_StreamFrames= true;
+        }
+        if (file_line.find("_BoundsOutput") != std::string::npos)
+        {
+            data_file >> _BoundsOutput;
+            if_BoundsOutput= true;
+        }
+        if (file_line.find("_RacingSeeds") != std::string::npos)
+        {
+            data_file >> _RacingSeeds;
+            if_RacingSeeds= true;
+        }
+        if (file_line.find("_AdaptiveWidth") != std::string::npos)
+        {
+            data_file >> _AdaptiveFrameWidth >> _AdaptiveDelayedWidth;
+            if_AdaptiveWidth= true;
+        }
+        if (file_line.find("_SteadyState") != std::string::npos)
+        {
+            data_file >> _SteadyStateWidth;
+            if_SteadyState= true;
+        }
         if (file_line.find("Methods") != std::string::npos)
         {
             while (!data_file.eof())
@@ -121,6 +166,16 @@ void Readfile::Read_data_file()
         std::cerr << "Error: End seed is smaller or equal to the starting seed. Aborting!\n";
         exit(1);
     }
+    if (_Sampling != "Plain" && _Sampling != "Antithetic" && _Sampling != "LatinHypercube")
+    {
+        std::cerr << "Error: Unknown sampling " << _Sampling << " (Plain, Antithetic or LatinHypercube). Aborting!\n";
+        exit(1);
+    }
+    if (_Sampling != "Plain" && _ImportanceShift != 0.0)
+    {
+        std::cerr << "Error: _ImportanceShift only shifts the times of the Plain sampling. Aborting!\n";
+        exit(1);
+    }
 
 }
 
@@ -129,6 +184,47 @@ void Readfile::PrintStatus()
     std::cout << "-- Information read from input file: --\n";
     std::cout << "Number of frames: " << _nbFrame << "\n";
     std::cout << "RNG Seeds: [" << _nbStartSeed << "," << _nbEndSeed <<"[\n";
+    if (_CounterRng || _Sampling != "Plain" || _ImportanceShift != 0.0)
+    {
+        std::cout << "RNG: counter-based\n";
+    }
+    if (_Sampling != "Plain")
+    {
+        std::cout << "Sampling: " << _Sampling << "\n";
+    }
+    if (_ImportanceShift != 0.0)
+    {
+        std::cout << "Importance sampling: longest steps of the critical path shifted by up to " << _ImportanceShift << "\n";
+    }
+    if (if_SampleCache)
+    {
+        std::cout << "Sample cache: " << _SampleCache << "\n";
+    }
+    if (_StreamFrames > 0)
+    {
+        std::cout << "Frames streamed " << _StreamFrames << " at a time\n";
+    }
+    if (_BoundsOutput)
+    {
+        std::cout << "Frame lower bounds written to the results\n";
+    }
+    if (_RacingSeeds > 0)
+    {
+        std::cout << "Methods raced on " << _RacingSeeds << " seeds at a time\n";
+    }
+    if (_AdaptiveFrameWidth > 0.0)
+    {
+        std::cout << "Seeds run until the 95% intervals are narrower than " << _AdaptiveFrameWidth << " us (mean frame) and " << _AdaptiveDelayedWidth << " frames (DF)\n";
+    }
+    if (if_SteadyState)
+    {
+        std::cout << "Warm-up and steady state of each lag regime written to the results";
+        if (_SteadyStateWidth > 0.0)
+        {
+            std::cout << ", frames stopped once the steady means are known within " << _SteadyStateWidth * 100.0 << "%";
+        }
+        std::cout << "\n";
+    }
     std::cout << "Scheduling methods to run: \n";
     for (std::string method: Methods)
     {
@@ -146,6 +242,18 @@ void Readfile::FillParameters(SimulationParameters& parameters)
 	parameters.IsDivided = this->Get_IsDivided();
     parameters.JsonOutput = this->Get_JsonOutput();
     parameters.SortingSteps = this->Get_SortingSteps();
+    // The antithetic, Latin hypercube and importance sampling draws are made with the counter-based generator
+    parameters.CounterRng = this->Get_CounterRng() || _Sampling != "Plain" || _ImportanceShift != 0.0;
+    parameters.ImportanceShift = this->Get_ImportanceShift();
+    parameters.Sampling = (_Sampling == "Antithetic") ? SamplingMode::ANTITHETIC : (_Sampling == "LatinHypercube") ? SamplingMode::LATIN_HYPERCUBE : SamplingMode::PLAIN;
+    parameters.SampleCacheFolder = this->Get_SampleCache();
+    parameters.StreamFrames = this->Get_StreamFrames();
+    parameters.BoundsOutput = this->Get_BoundsOutput();
+    parameters.SteadyStateOutput = this->Get_SteadyState();
+    parameters.SteadyStateWidth = this->Get_SteadyStateWidth();
+    parameters.RacingSeeds = this->Get_RacingSeeds();
+    parameters.AdaptiveFrameWidth = this->Get_AdaptiveFrameWidth();
+    parameters.AdaptiveDelayedWidth = this->Get_AdaptiveDelayedWidth();
     
 };
 
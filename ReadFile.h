@@ -8,10 +8,11 @@ class Readfile
 {
 private:
   std::string file_name_;
-  int _nbFrame, _nbStartSeed, _nbEndSeed;
+  int _nbFrame, _nbStartSeed, _nbEndSeed, _StreamFrames, _RacingSeeds;
+  double _AdaptiveFrameWidth, _AdaptiveDelayedWidth, _ImportanceShift, _SteadyStateWidth;
   std::vector<int> _nbWorkers;
-  std::string _mode, FileSequenceName, FileTaskName;
-  bool _IsDivided, _JsonOutput,_SortingSteps;
+  std::string _mode, FileSequenceName, FileTaskName, _SampleCache, _Sampling;
+  bool _IsDivided, _JsonOutput,_SortingSteps,_CounterRng,_BoundsOutput;
   std::vector<std::string> Methods ;
 
   bool print_info_;
@@ -26,6 +27,15 @@ private:
   bool if_Methods;
   bool if_JsonOutput;
   bool if_SortingSteps;
+  bool if_CounterRng;
+  bool if_SampleCache;
+  bool if_StreamFrames;
+  bool if_BoundsOutput;
+  bool if_RacingSeeds;
+  bool if_AdaptiveWidth;
+  bool if_Sampling;
+  bool if_ImportanceShift;
+  bool if_SteadyState;
 public:
   //constructor
   Readfile(std::string file_name);
@@ -42,6 +52,17 @@ public:
   const bool Get_IsDivided() const { return _IsDivided; };
   const bool Get_JsonOutput() const { return _JsonOutput; };
   const bool Get_SortingSteps() const { return _SortingSteps; };
+  const bool Get_CounterRng() const { return _CounterRng; };
+  const std::string Get_SampleCache() const { return _SampleCache; };
+  const std::string Get_Sampling() const { return _Sampling; };
+  const double Get_ImportanceShift() const { return _ImportanceShift; };
+  const int Get_StreamFrames() const { return _StreamFrames; };
+  const bool Get_BoundsOutput() const { return _BoundsOutput; };
+  const int Get_RacingSeeds() const { return _RacingSeeds; };
+  const double Get_AdaptiveFrameWidth() const { return _AdaptiveFrameWidth; };
+  const double Get_AdaptiveDelayedWidth() const { return _AdaptiveDelayedWidth; };
+  const bool Get_SteadyState() const { return if_SteadyState; };
+  const double Get_SteadyStateWidth() const { return _SteadyStateWidth; };
   const std::vector<std::string> Get_methods() const { return Methods; };
   void PrintStatus();
   void FillParameters(SimulationParameters& _parameters);
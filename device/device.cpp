@@ -10,11 +10,16 @@ Device::Device(const int _iNbWorker, std::string Strategy,bool outside)
     for (int i = 0; i < _iNbWorker; i++)
     {
         m_workers.push_back(new Worker(i));
+        m_idleWorkers.insert(i);
     }
     for (int i = 0; i < _iNbWorker; i++)
     {
         m_workers[i]->outside=outside;
     }
+    m_firstPhaseTask = nullptr;
+    m_secondPhaseTask = nullptr;
+    m_nbFirstPhaseWorkers = 0;
+    m_nbSecondPhaseWorkers = 0;
     cpt=0;
     cpt2=0;
 }
@@ -23,6 +28,11 @@ Device::~Device()
 {
     delete m_scheduler;
     m_scheduler = nullptr;
+    for (Worker* worker : m_workers)
+    {
+        delete worker;
+    }
+    m_workers.clear();
 }
 
 Device* Device::CreateDevice(const int _iNbWorker, std::string Strategy,bool outside)
@@ -30,13 +40,15 @@ Device* Device::CreateDevice(const int _iNbWorker, std::string Strategy,bool out
     return new Device(_iNbWorker,Strategy,outside);
 }
 
-void Device::PlaySequence(TaskSequence& _sequence, double _lagProportion)
+void Device::PlaySequence(SequenceState& _state, double _lagProportion)
 {
     cpt=0;
     cpt2=0;
     if (m_scheduler != nullptr)
     {
-        m_scheduler->SetSequence(_sequence, _lagProportion);
+        m_firstPhaseTask = _state.GetSequence().GetTask(P_TASK);
+        m_secondPhaseTask = _state.GetSequence().GetTask(S_TASK);
+        m_scheduler->SetSequence(_state, _lagProportion);
         do
         {
             UpdateWorkers();
@@ -47,21 +59,36 @@ void Device::PlaySequence(TaskSequence& _sequence, double _lagProportion)
     }
 }
 
+// One event: the worker whose step ends first is released, then the idle workers get new tasks.
+// The first call of a frame has no step to end.
 void Device::UpdateWorkers()
 {
     if (m_scheduler != nullptr)
     {
-        int iWorkerId = GetNextAvailableWorkerId();
-        double timeSpent = m_workers[iWorkerId]->Execute();
-
-        m_scheduler->Update(m_workers[iWorkerId]->GetcurrentcoreTime());
-        for (int i = 0; i < m_workers.size(); i++)
+        double eventTime = m_clockTime;
+        if (!m_events.Empty())
         {
-            m_workers[i]->UpdateTime(timeSpent);
-            m_workers[i]->FetchNewTaskIfAvailable(m_scheduler);
+            EventQueue::Event event = m_events.Pop();
+            Worker* worker = m_workers[event.m_workerId];
+            const Task* task = worker->GetCurrentTask()->GetTask();
+            m_nbFirstPhaseWorkers -= (task == m_firstPhaseTask);
+            m_nbSecondPhaseWorkers -= (task == m_secondPhaseTask);
+            worker->Execute(m_scheduler);
+            m_idleWorkers.insert(event.m_workerId);
+            eventTime = event.m_time;
         }
-        
-        m_clockTime += timeSpent;
+
+        m_scheduler->Update(m_clockTime);
+        m_clockTime = eventTime;
+
+        // Steps ending at the same time have no remaining time left, although their workers are released by the next events
+        m_events.ForEachDue(m_clockTime, [this](const EventQueue::Event& _event)
+        {
+            m_workers[_event.m_workerId]->UpdateTime(m_scheduler, m_clockTime);
+        });
+
+        FetchTasks();
+
         if(FirstPhase()&cpt==0)
         {
             AddFirstPhase(m_clockTime);
@@ -76,41 +103,44 @@ void Device::UpdateWorkers()
     }
 }
 
-int Device::GetNextAvailableWorkerId()
-{
-    return GetNextAvailableWorkerId(m_scheduler->HasAvailableTask());
-}
-
-int Device::GetNextAvailableWorkerId(bool _includeIdleWorkers)
+// Idle workers take the available tasks by increasing id.
+// Worker 0 also runs the graphic tasks; the other workers are interchangeable, so once one of them
+// cannot get a task, the following ones cannot either.
+void Device::FetchTasks()
 {
-    int iWorkerId = 0;
-    double fMinRemainingTime = std::numeric_limits<double>().max();
-    for (int i = 0; i < m_workers.size(); i++)
+    std::set<int>::iterator it = m_idleWorkers.begin();
+    while (it != m_idleWorkers.end())
     {
-        if (_includeIdleWorkers || m_workers[i]->IsProcessingTask())
+        int iWorkerId = *it;
+        if (!m_scheduler->HasAvailableTaskFor(iWorkerId))
         {
-            double fRemainingTime = m_workers[i]->GetRemainingTime();
-            if (fRemainingTime < fMinRemainingTime)
+            if (iWorkerId != 0)
             {
-                fMinRemainingTime = fRemainingTime;
-                iWorkerId = i;
+                break;
             }
+            ++it;
+            continue;
         }
-    }
 
-    return iWorkerId;
+        Worker* worker = m_workers[iWorkerId];
+        if (worker->FetchNewTaskIfAvailable(m_scheduler, m_clockTime))
+        {
+            const Task* task = worker->GetCurrentTask()->GetTask();
+            m_nbFirstPhaseWorkers += (task == m_firstPhaseTask);
+            m_nbSecondPhaseWorkers += (task == m_secondPhaseTask);
+            m_events.Push(worker->GetFinishTime(), iWorkerId);
+            it = m_idleWorkers.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
 }
 
 bool Device::IsProcessingTask()
 {
-    for (Worker* worker : m_workers)
-    {
-        if (worker->IsProcessingTask())
-        {
-            return true;
-        }
-    }
-    return false;
+    return !m_events.Empty();
 }
 
 void Device::DestroyDevice(Device* _device)
@@ -124,34 +154,17 @@ double Device::GetGlobalClockTime()
     return m_clockTime;
 }
 
-double Device::GetBestTime(int _frameIndex)
+double Device::GetBestTime()
 {
-    return m_scheduler->GetBestTime(_frameIndex);
+    return m_scheduler->GetBestTime();
 }
 
 bool Device::FirstPhase()
 {
-    bool EndPahase=false;
-    for(int i=0;i<m_workers.size();i++)
-    {
-        if(m_workers[i]->FirstPhase())
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_nbFirstPhaseWorkers > 0;
 };
 
 bool Device::SecondPhase()
 {
-    bool EndPahase=false;
-    for(int i=0;i<m_workers.size();i++)
-    {
-        if(m_workers[i]->SecondPhase())
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_nbSecondPhaseWorkers > 0;
 };
-
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <set>
 #include <vector>
 
 #include "../tasks/taskSequence.h"
+#include "../tasks/sequenceState.h"
 #include "../scheduler/scheduler.h"
 #include "../workers/worker.h"
+#include "eventQueue.h"
 
 class Device
 {
@@ -15,14 +18,12 @@ public:
     static Device* CreateDevice(const int _iNbWorker,std::string Strategy,bool outside);
     static void DestroyDevice(Device* _device);
     
-    void PlaySequence(TaskSequence& _sequence, double _lagProportion);
+    void PlaySequence(SequenceState& _state, double _lagProportion);
     void UpdateWorkers();
-    int GetNextAvailableWorkerId();
-    int GetNextAvailableWorkerId(bool _includeIdleWorkers);
     bool IsProcessingTask();
 
     double GetGlobalClockTime();
-    double GetBestTime(int _frameIndex);
+    double GetBestTime();
 
     //FIRST PHASE:
     bool FirstPhase();
@@ -34,11 +35,19 @@ public:
     double GetSecondPhase(){return m_beginSecondPhase;};
 
 private:
+    void FetchTasks();
+
     Scheduler* m_scheduler;
     std::vector<Worker*> m_workers;
+    EventQueue m_events;        // workers processing a step, by finish time
+    std::set<int> m_idleWorkers; // workers waiting for a task, by id
+    const Task* m_firstPhaseTask;
+    const Task* m_secondPhaseTask;
+    int m_nbFirstPhaseWorkers;  // workers processing P_TASK
+    int m_nbSecondPhaseWorkers; // workers processing S_TASK
     int cpt;
     int cpt2;
     double m_beginFirstPhase;
     double m_beginSecondPhase;
     double m_clockTime;
-};
\ No newline at end of file
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <vector>
+
+// Min-heap of the workers processing a step, ordered by the absolute time at which their step ends.
+// On ties, the worker with the lowest id comes first.
+class EventQueue
+{
+public:
+    struct Event
+    {
+        double m_time;
+        int m_workerId;
+    };
+
+    bool Empty() const { return m_heap.empty(); };
+    int Size() const { return m_heap.size(); };
+    const Event& Top() const { return m_heap.front(); };
+    void Clear() { m_heap.clear(); };
+
+    void Push(double _time, int _workerId)
+    {
+        m_heap.push_back({ _time, _workerId });
+        SiftUp(m_heap.size() - 1);
+    }
+
+    Event Pop()
+    {
+        Event top = m_heap.front();
+        m_heap.front() = m_heap.back();
+        m_heap.pop_back();
+        if (!m_heap.empty())
+        {
+            SiftDown(0);
+        }
+        return top;
+    }
+
+    // Calls _function on every event ending no later than _time, without removing them
+    template <typename Function>
+    void ForEachDue(double _time, Function _function) const
+    {
+        ForEachDue(0, _time, _function);
+    }
+
+private:
+    static bool Before(const Event& _a, const Event& _b)
+    {
+        return _a.m_time < _b.m_time || (_a.m_time == _b.m_time && _a.m_workerId < _b.m_workerId);
+    }
+
+    template <typename Function>
+    void ForEachDue(size_t _index, double _time, Function& _function) const
+    {
+        if (_index >= m_heap.size() || m_heap[_index].m_time > _time)
+        {
+            return;
+        }
+        _function(m_heap[_index]);
+        ForEachDue(2 * _index + 1, _time, _function);
+        ForEachDue(2 * _index + 2, _time, _function);
+    }
+
+    void SiftUp(size_t _index)
+    {
+        while (_index > 0)
+        {
+            size_t parent = (_index - 1) / 2;
+            if (!Before(m_heap[_index], m_heap[parent]))
+            {
+                break;
+            }
+            std::swap(m_heap[_index], m_heap[parent]);
+            _index = parent;
+        }
+    }
+
+    void SiftDown(size_t _index)
+    {
+        while (true)
+        {
+            size_t first = _index;
+            size_t left = 2 * _index + 1;
+            size_t right = left + 1;
+            if (left < m_heap.size() && Before(m_heap[left], m_heap[first]))
+            {
+                first = left;
+            }
+            if (right < m_heap.size() && Before(m_heap[right], m_heap[first]))
+            {
+                first = right;
+            }
+            if (first == _index)
+            {
+                break;
+            }
+            std::swap(m_heap[_index], m_heap[first]);
+            _index = first;
+        }
+    }
+
+    std::vector<Event> m_heap;
+};
@@ -5,14 +5,15 @@
 #include "assert.h"
 
 
-Profiler* Profiler::ms_instance = nullptr;
+thread_local Profiler* Profiler::ms_instance = nullptr;
 
-Profiler::Profiler(){}
+Profiler::Profiler() : m_record(true) {}
 Profiler::~Profiler(){}
 
-void Profiler::StartProfiling()
+void Profiler::StartProfiling(bool _record)
 {
     ms_instance = new Profiler();
+    ms_instance->m_record = _record;
 }
 
 Profiler* Profiler::GetInstance()
@@ -51,6 +52,10 @@ void Profiler::DumpReport(const std::string& _report)
 
 void Profiler::AddKeyFrame(int _workerId, std::string _taskName, std::string _taskType, double _timeStart, KEY_EVENT_TYPE _type, int _currentStep, int _step)
 {
+    if (!m_record)
+    {
+        return;
+    }
     KeyFrame key = {
         _workerId,
         _taskName,
@@ -12,7 +12,8 @@ public:
 
     Profiler();
     ~Profiler();
-    static void StartProfiling();
+    // _record: keep the key frames for DumpReport, else they are ignored
+    static void StartProfiling(bool _record = true);
     static Profiler* GetInstance();
     void DumpReport(const std::string& _report);
     void Clear();
@@ -22,7 +23,8 @@ public:
     
 private:
 
-    static Profiler* ms_instance;
+    // One profiler per thread, so that simulations running in parallel do not share their reports
+    static thread_local Profiler* ms_instance;
 
     struct KeyFrame {
         int m_workerId;
@@ -35,5 +37,6 @@ private:
     };
 
     std::vector<KeyFrame> m_profiledTasks;
+    bool m_record;
 };
 
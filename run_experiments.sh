@@ -1,24 +1,27 @@
 #!/bin/bash
 
+# Number of simulations run in parallel (0: one per hardware thread)
+JOBS=${JOBS:-0}
+
 echo "-- Compiling --"
 make
 
 echo "-- Simulating the critical path for scenarios 1 and 2 --"
-./engine_simulator input_CP_scenario_1.txt
+./engine_simulator input_CP_scenario_1.txt --jobs $JOBS
 mv Result/ Result_CP_1/
 
 echo "-- Simulating scenario 1 --"
-./engine_simulator input_scenario_1.txt
+./engine_simulator input_scenario_1.txt --jobs $JOBS
 mv Result/ Result_1/
 
 echo "-- Simulating scenario 2 --"
-./engine_simulator input_scenario_2.txt
+./engine_simulator input_scenario_2.txt --jobs $JOBS
 mv Result/ Result_2/
 
 echo "-- Simulating the critical path for scenario 3 --"
-./engine_simulator input_CP_scenario_3.txt
+./engine_simulator input_CP_scenario_3.txt --jobs $JOBS
 mv Result/ Result_CP_3/
 
 echo "-- Simulating scenario 3 --"
-./engine_simulator input_scenario_3.txt
+./engine_simulator input_scenario_3.txt --jobs $JOBS
 mv Result/ Result_3/
@@ -4,6 +4,7 @@
 
 #include "scheduler/strategies/strategy.h"
 #include "../tasks/taskSequence.h"
+#include "../tasks/sequenceState.h"
 #include "../tasks/task.h"
 
 class Scheduler
@@ -12,13 +13,15 @@ public:
     Scheduler(const int _iNbWorkers,std::string Strategy);
     ~Scheduler();
 
-    void SetSequence(TaskSequence& _sequence, double _lagProportion);
+    void SetSequence(SequenceState& _state, double _lagProportion);
     bool HasWaitingTask();
     bool HasAvailableTask();
+    bool HasAvailableTaskFor(int _workerId);
 
     void Update(double _BW);
-    Task* GetNextAvailableTask(int _workerId, int& _stepToProcess);
-    double GetBestTime(int _frameIndex);
+    void OnTaskDone(TaskState* _task);
+    TaskState* GetNextAvailableTask(int _workerId, int& _stepToProcess);
+    double GetBestTime();
 
     //ThreePhase:
     void AddPhase(int _pahseNumber){m_phase=_pahseNumber;};
@@ -26,6 +29,12 @@ public:
 
 private:
 	Strategy* m_strategy;
-    std::vector<Task*> m_waitingTasks;
+    SequenceState* m_state;
+    //NUMBER OF FATHERS NOT DONE YET AND RANK IN THE TASK NAME ORDER, BY TASK INDEX
+    std::vector<int> m_remainingFathers;
+    std::vector<int> m_waitingRank;
+    //TASKS WHOSE FATHERS ARE ALL DONE, PUSHED TO THE STRATEGY AT THE NEXT UPDATE
+    std::vector<TaskState*> m_readyTasks;
+    int m_nbWaitingTasks;
     int m_phase;
 };
\ No newline at end of file
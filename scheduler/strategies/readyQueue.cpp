@@ -0,0 +1,40 @@
+#include <stdafx.h>
+
+#include "readyQueue.h"
+
+ReadyQueue::ReadyQueue()
+{
+	m_newestFirst = false;
+	Clear();
+}
+
+void ReadyQueue::Clear()
+{
+	m_heap.clear();
+	m_pending.clear();
+	m_firstOrder = 0;
+	m_lastOrder = 0;
+	m_descending = false;
+	m_frontChanged = false;
+	m_keyVersion = 0;
+}
+
+void ReadyQueue::Push(TaskState* _task)
+{
+	m_pending.push_back(_task);
+}
+
+void ReadyQueue::PopFront()
+{
+	m_heap.front() = m_heap.back();
+	m_heap.pop_back();
+	if (!m_heap.empty() && m_descending)
+	{
+		SiftDown<true>(0);
+	}
+	else if (!m_heap.empty())
+	{
+		SiftDown<false>(0);
+	}
+	m_frontChanged = false;
+}
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "../../tasks/taskState.h"
+
+// Ready tasks of a strategy, kept in a binary heap ordered by priority.
+// Sorting the queue gives the same order as a stable sort of its previous order: tasks of
+// same priority stay in the order they were pushed (or the reverse, with SetNewestFirst).
+class ReadyQueue
+{
+public:
+	ReadyQueue();
+
+	void Clear();
+	void Push(TaskState* _task);
+	bool Empty() const { return m_heap.empty() && m_pending.empty(); };
+	size_t Size() const { return m_heap.size() + m_pending.size(); };
+
+	//TASKS OF SAME PRIORITY: THE LAST PUSHED FIRST
+	void SetNewestFirst(bool _newestFirst) { m_newestFirst = _newestFirst; };
+
+	//ORDER THE QUEUE BY PRIORITY: THE PRIORITIES OF ALL THE TASKS ARE READ AGAIN WHEN _keyVersion CHANGES
+	template <class PRIORITY>
+	void Sort(PRIORITY _priority, bool _descending, int _keyVersion);
+	//SAME WITH THE ORDER KNOWN AT COMPILE TIME: THE COMPARISONS OF THE HEAP ARE INLINED
+	template <bool DESCENDING, class PRIORITY>
+	void Sort(PRIORITY _priority, int _keyVersion);
+
+	//FRONT TASK, ONLY VALID AFTER A SORT
+	TaskState* Front() const { return m_heap.front().m_task; };
+	void PopFront();
+
+	//THE PRIORITY OF THE FRONT TASK CHANGED: READ AGAIN AT THE NEXT SORT
+	void FrontChanged() { m_frontChanged = true; };
+
+private:
+	struct Entry
+	{
+		TaskState* m_task;
+		double m_key;
+		//KEY READ FOR A NEW _keyVersion, BEFORE THE QUEUE IS SORTED AGAIN
+		double m_nextKey;
+		long long m_order;
+	};
+
+	static bool SameKey(double _a, double _b) { return _a == _b || (std::isnan(_a) && std::isnan(_b)); };
+
+	template <bool DESCENDING>
+	static bool Before(const Entry& _a, const Entry& _b);
+	template <bool DESCENDING>
+	void SiftUp(size_t _pos);
+	template <bool DESCENDING>
+	void SiftDown(size_t _pos);
+	template <bool DESCENDING>
+	void Heapify();
+	//STABLE SORT OF THE HEAP IN ITS CURRENT ORDER, BEFORE NEW PRIORITIES ARE READ
+	template <bool DESCENDING>
+	void SortEntries();
+
+	std::vector<Entry> m_heap;
+	//PUSHED SINCE THE LAST SORT, IN PUSH ORDER
+	std::vector<TaskState*> m_pending;
+	long long m_firstOrder;
+	long long m_lastOrder;
+	bool m_descending;
+	bool m_newestFirst;
+	bool m_frontChanged;
+	int m_keyVersion;
+};
+
+template <class PRIORITY>
+void ReadyQueue::Sort(PRIORITY _priority, bool _descending, int _keyVersion)
+{
+	if (_descending)
+	{
+		Sort<true>(_priority, _keyVersion);
+	}
+	else
+	{
+		Sort<false>(_priority, _keyVersion);
+	}
+}
+
+template <bool DESCENDING, class PRIORITY>
+void ReadyQueue::Sort(PRIORITY _priority, int _keyVersion)
+{
+	bool frontChanged = m_frontChanged && !m_heap.empty();
+	if (frontChanged)
+	{
+		// The front task stays before the tasks of same priority
+		m_heap.front().m_order = --m_firstOrder;
+	}
+
+	// Tasks of same new priority keep their current order. A phase changes the priority function of
+	// the strategies that have phases, so all the keys change at once, a few times per frame: the whole
+	// queue is then sorted again. The strategies without phases keep their keys and skip that sort.
+	bool keysChanged = false;
+	if (_keyVersion != m_keyVersion)
+	{
+		for (Entry& entry : m_heap)
+		{
+			entry.m_nextKey = _priority(entry.m_task);
+			keysChanged = keysChanged || !SameKey(entry.m_key, entry.m_nextKey);
+		}
+	}
+	if (keysChanged)
+	{
+		if (m_descending)
+		{
+			SortEntries<true>();
+		}
+		else
+		{
+			SortEntries<false>();
+		}
+		m_firstOrder -= m_heap.size();
+		for (size_t i = 0; i < m_heap.size(); i++)
+		{
+			m_heap[i].m_order = m_firstOrder + i;
+			m_heap[i].m_key = m_heap[i].m_nextKey;
+		}
+		m_descending = DESCENDING;
+		Heapify<DESCENDING>();
+	}
+	else
+	{
+		if (frontChanged)
+		{
+			m_heap.front().m_key = _priority(m_heap.front().m_task);
+		}
+		if (DESCENDING != m_descending)
+		{
+			m_descending = DESCENDING;
+			Heapify<DESCENDING>();
+		}
+		else if (frontChanged)
+		{
+			SiftDown<DESCENDING>(0);
+		}
+	}
+	m_frontChanged = false;
+	m_keyVersion = _keyVersion;
+
+	for (TaskState* task : m_pending)
+	{
+		double key = _priority(task);
+		Entry entry = { task, key, key, m_newestFirst ? --m_firstOrder : ++m_lastOrder };
+		m_heap.push_back(entry);
+		SiftUp<DESCENDING>(m_heap.size() - 1);
+	}
+	m_pending.clear();
+}
+
+// A task without a priority (NaN) goes after the others
+template <bool DESCENDING>
+bool ReadyQueue::Before(const Entry& _a, const Entry& _b)
+{
+	bool aIsNan = std::isnan(_a.m_key);
+	bool bIsNan = std::isnan(_b.m_key);
+	if (aIsNan != bIsNan)
+	{
+		return bIsNan;
+	}
+	if (!aIsNan && _a.m_key != _b.m_key)
+	{
+		return DESCENDING ? _a.m_key > _b.m_key : _a.m_key < _b.m_key;
+	}
+	return _a.m_order < _b.m_order;
+}
+
+template <bool DESCENDING>
+void ReadyQueue::SiftUp(size_t _pos)
+{
+	while (_pos > 0)
+	{
+		size_t parent = (_pos - 1) / 2;
+		if (!Before<DESCENDING>(m_heap[_pos], m_heap[parent]))
+		{
+			break;
+		}
+		std::swap(m_heap[_pos], m_heap[parent]);
+		_pos = parent;
+	}
+}
+
+template <bool DESCENDING>
+void ReadyQueue::SiftDown(size_t _pos)
+{
+	size_t size = m_heap.size();
+	while (true)
+	{
+		size_t best = _pos;
+		size_t left = 2 * _pos + 1;
+		size_t right = left + 1;
+		if (left < size && Before<DESCENDING>(m_heap[left], m_heap[best]))
+		{
+			best = left;
+		}
+		if (right < size && Before<DESCENDING>(m_heap[right], m_heap[best]))
+		{
+			best = right;
+		}
+		if (best == _pos)
+		{
+			break;
+		}
+		std::swap(m_heap[_pos], m_heap[best]);
+		_pos = best;
+	}
+}
+
+template <bool DESCENDING>
+void ReadyQueue::Heapify()
+{
+	for (size_t i = m_heap.size() / 2; i > 0; i--)
+	{
+		SiftDown<DESCENDING>(i - 1);
+	}
+}
+
+template <bool DESCENDING>
+void ReadyQueue::SortEntries()
+{
+	std::sort(m_heap.begin(), m_heap.end(), Before<DESCENDING>);
+}
@@ -1,501 +1,246 @@
 #include <stdafx.h>
 
 #include "strategy.h"
+#include "strategyRegistry.h"
 #define debug(i) std::cout <<"line= "<<__LINE__<<" , "<<#i<<" = "<< i << std::endl;
 
-void Strategy::Initialize(Task* _lastTask, Task* _firstTask)
+Strategy::Strategy()
 {
-	m_availableEngineTasks.clear();
-	m_availableGraphicTasks.clear();
+	m_taskCount = 0;
+	m_hasPreviousFrame = false;
+	m_phase = 0;
+	m_bestTime = 0.0;
+}
+
+void Strategy::Initialize(const Task* _lastTask, const Task* _firstTask, int _taskCount)
+{
+	if (m_taskCount != _taskCount)
+	{
+		m_taskCount = _taskCount;
+		m_fathersFirst.clear();
+		m_hasPreviousFrame = false;
+		m_PreviousExecTime.assign(m_taskCount, 0.0);
+		m_PreviousMaxStep.assign(m_taskCount, 0.0);
+		m_previousFrameExecTime.assign(m_taskCount, 0.0);
+	}
+	m_availableEngineTasks.Clear();
+	m_availableGraphicTasks.Clear();
 	m_criticalPath.clear();
-	m_previousFrameinducedTime.clear();
-	m_tie_break=false;
-	m_FirstVariantPrevious.clear();
-	m_SecondVariantPrevious.clear();
+	m_previousFrameinducedTime.assign(m_taskCount, 0.0);
+	m_FirstVariantPrevious.assign(m_taskCount, 0.0);
+	m_SecondVariantPrevious.assign(m_taskCount, 0.0);
 	m_firstVariantCriticalPath.clear();
 	m_secondVariantCriticalPath.clear();
 	m_phase=0;
 
-	if (!m_previousFrameExecTime.empty())
-	{
-		AddTaskInducedTime(_lastTask, 0, std::vector<Task*>());
-		
-	}
-	m_bestTime.push_back(m_previousFrameinducedTime[_firstTask]);
-
-	if(!m_PreviousMaxStep.empty())
-	{
-		FirstVariantInducedTime(_lastTask, 0, std::vector<Task*>());
-	}
-
-	if(!m_PreviousExecTime.empty())
+	if (m_hasPreviousFrame)
 	{
-		SecondVariantInducedTime(_lastTask, 0, std::vector<Task*>());
+		ComputeInducedTimes(_lastTask, m_previousFrameExecTime, m_previousFrameinducedTime, m_criticalPath);
+		ComputeInducedTimes(_lastTask, m_PreviousMaxStep, m_FirstVariantPrevious, m_firstVariantCriticalPath);
+		ComputeInducedTimes(_lastTask, m_PreviousExecTime, m_SecondVariantPrevious, m_secondVariantCriticalPath);
 	}
+	m_bestTime = m_previousFrameinducedTime[_firstTask->GetIndex()];
 }
 
-void Strategy::PushAvailableTask(Task* _task)
+void Strategy::PushAvailableTask(TaskState* _task)
 {
-	if (_task->GetTaskType() == "engine")
+	if (_task->GetTask()->GetTaskType() == TaskType::ENGINE)
 	{
-		m_availableEngineTasks.push_back(_task);
+		m_availableEngineTasks.Push(_task);
 	}
 	else
 	{
-		m_availableGraphicTasks.push_back(_task);
+		m_availableGraphicTasks.Push(_task);
 	}
 	AddTaskTime(_task);
 }
 
-void Strategy::AddTaskTime(Task* _task)
+void Strategy::AddTaskTime(TaskState* _task)
 {
 	if (_task != nullptr)
 	{
-		double maxStepTime = 0;
-		double cumulTime = 0;
-		for (int i = 0; i < _task->GetStepCount(); i++)
-		{
-			maxStepTime = std::max(maxStepTime, _task->GetRemainingTimeForStep(i));
-			cumulTime += _task->GetRemainingTimeForStep(i);
-		}
-		m_PreviousMaxStep[_task]=maxStepTime;
-		m_PreviousExecTime[_task]=cumulTime;
-		m_previousFrameExecTime[_task] = std::max(maxStepTime, cumulTime / std::min(_task->GetStepCount(), m_workerCount));
+		// A task is pushed before any of its steps is processed
+		double maxStepTime = _task->GetStartLongestTime();
+		double cumulTime = _task->GetStartTotalTime();
+		int index = _task->GetTask()->GetIndex();
+		m_PreviousMaxStep[index]=maxStepTime;
+		m_PreviousExecTime[index]=cumulTime;
+		m_hasPreviousFrame = true;
+		m_previousFrameExecTime[index] = std::max(maxStepTime, cumulTime / std::min(_task->GetStepCount(), m_workerCount));
 	}
 }
 
 
-void Strategy::AddTaskInducedTime(Task* _task, double _inducedTime, std::vector<Task*> _criticalPath)
+// Longest time from each task to the end of the last task, the task itself excluded, with _execTime
+// as the duration of the tasks: one pass over the tasks, each one before its fathers.
+// The critical path is the last of the longest paths in the order of the fathers.
+void Strategy::ComputeInducedTimes(const Task* _lastTask, std::vector<double>& _execTime, std::vector<double>& _inducedTime, std::vector<bool>& _criticalPath)
 {
-	std::vector<Task*> fathers = _task->GetFathers();
-
-	if (m_previousFrameinducedTime[_task] <= _inducedTime)
+	if (m_fathersFirst.empty())
 	{
-		m_previousFrameinducedTime[_task] = _inducedTime;
-		_criticalPath.push_back(_task);
-
-		if (fathers.empty()) {
-			m_criticalPath = _criticalPath;
-			return;
-		}
-
-		for (std::vector<Task*>::iterator it = fathers.begin(); it != fathers.end(); it++)
-		{
-			AddTaskInducedTime(*it, m_previousFrameinducedTime[_task] + m_previousFrameExecTime[_task], _criticalPath);
-		}
+		std::vector<bool> visited(m_taskCount, false);
+		AddFathersFirst(_lastTask, visited);
 	}
-}
 
-Task* Strategy::GetNextAvailableTask(int _workerId, int& _stepToProcess)
-{
-	Task* task = nullptr;
-	if (_workerId == 0)
+	_inducedTime[_lastTask->GetIndex()] = 0.0;
+	for (std::vector<const Task*>::reverse_iterator it = m_fathersFirst.rbegin(); it != m_fathersFirst.rend(); it++)
 	{
-		if (m_availableGraphicTasks.size() > 0)
+		double inducedTime = _inducedTime[(*it)->GetIndex()] + _execTime[(*it)->GetIndex()];
+		for (Task* father : (*it)->GetFathers())
 		{
-			bubbleSort(m_availableGraphicTasks);
-			task = m_availableGraphicTasks.front();
-			if (task != nullptr && task->HasFreeStepToProcess())
-			{
-				_stepToProcess = task->ClaimFreeStep();
-			}
-
-			if (task == nullptr || !task->HasFreeStepToProcess())
+			if (_inducedTime[father->GetIndex()] <= inducedTime)
 			{
-				m_availableGraphicTasks.erase(m_availableGraphicTasks.begin());
+				_inducedTime[father->GetIndex()] = inducedTime;
 			}
-			return task;
 		}
 	}
-	
-	if (m_availableEngineTasks.size() > 0)
+
+	// Tasks from which a longest path goes up to a first task
+	std::vector<bool> reachesFirstTask(m_taskCount, false);
+	for (const Task* task : m_fathersFirst)
 	{
-		bubbleSort(m_availableEngineTasks);
-		
-		task = m_availableEngineTasks.front();
-		if (task != nullptr && task->HasFreeStepToProcess())
+		const std::vector<Task*>& fathers = task->GetFathers();
+		bool reaches = fathers.empty();
+		for (Task* father : fathers)
 		{
-			_stepToProcess = task->ClaimFreeStep();
+			reaches = reaches || (reachesFirstTask[father->GetIndex()] && _inducedTime[task->GetIndex()] + _execTime[task->GetIndex()] == _inducedTime[father->GetIndex()]);
 		}
+		reachesFirstTask[task->GetIndex()] = reaches;
+	}
 
-		if (task == nullptr || !task->HasFreeStepToProcess())
+	_criticalPath.assign(m_taskCount, false);
+	const Task* task = _lastTask;
+	while (task != nullptr)
+	{
+		_criticalPath[task->GetIndex()] = true;
+		const std::vector<Task*>& fathers = task->GetFathers();
+		const Task* next = nullptr;
+		for (std::vector<Task*>::const_reverse_iterator it = fathers.rbegin(); it != fathers.rend() && next == nullptr; it++)
 		{
-			m_availableEngineTasks.erase(m_availableEngineTasks.begin());
+			if (reachesFirstTask[(*it)->GetIndex()] && _inducedTime[task->GetIndex()] + _execTime[task->GetIndex()] == _inducedTime[(*it)->GetIndex()])
+			{
+				next = *it;
+			}
 		}
+		task = next;
 	}
-	
-	return task;
 }
 
-bool Strategy::HasAvailableTask()
+void Strategy::AddFathersFirst(const Task* _task, std::vector<bool>& _visited)
 {
-	return  (!m_availableEngineTasks.empty() && !m_availableGraphicTasks.empty());
+	int index = _task->GetIndex();
+	if (_visited[index])
+	{
+		return;
+	}
+	_visited[index] = true;
+	for (Task* father : _task->GetFathers())
+	{
+		AddFathersFirst(father, _visited);
+	}
+	m_fathersFirst.push_back(_task);
 }
 
-double Strategy::GetBestTime(int _frameIndex)
+TaskState* Strategy::GetNextAvailableTask(int _workerId, int& _stepToProcess)
 {
-	return m_bestTime[_frameIndex];
-}
-
-bool Strategy::IsOnCriticalPath(Task* _task) {
-	return (std::find(m_criticalPath.begin(), m_criticalPath.end(), _task) != m_criticalPath.end());
-}
-
-void Strategy::bubbleSort(std::vector<Task*> &vec) {
-	if (m_LessOrMore == "more")
+	if (_workerId == 0 && !m_availableGraphicTasks.Empty())
 	{
-		for (size_t i = 0; i < vec.size() - 1; ++i) {
-			for (size_t j = 0; j < vec.size() - i - 1; ++j) {
-				if (Priority(vec.at(j)) < Priority(vec.at(j + 1)))
-				{
-					std::swap(vec.at(j), vec.at(j + 1));
-				}
-				if (Priority(vec.at(j))==Priority(vec.at(j + 1))&& m_tie_break)
-				{
-					if(vec.at(j)->GetMean()<vec.at(j)->GetMean())
-						std::swap(vec.at(j), vec.at(j + 1));
-				}
-					
-			}
-		}
-	}
-	if (m_LessOrMore == "less")
-	{
-		for (size_t i = 0; i < vec.size() - 1; ++i) {
-			for (size_t j = 0; j < vec.size() - i - 1; ++j) {
-				if (Priority(vec.at(j)) > Priority(vec.at(j + 1)))
-					std::swap(vec.at(j), vec.at(j + 1));
-				if (Priority(vec.at(j))==Priority(vec.at(j + 1))&& m_tie_break)
-				{
-					if(vec.at(j)->GetMean()<vec.at(j)->GetMean())
-						std::swap(vec.at(j), vec.at(j + 1));
-				}
-			}
-		}
+		return ClaimFront(m_availableGraphicTasks, _stepToProcess);
 	}
-	if(m_LessOrMore == "other")
+	
+	if (!m_availableEngineTasks.Empty())
 	{
-
+		return ClaimFront(m_availableEngineTasks, _stepToProcess);
 	}
+	
+	return nullptr;
 }
 
-
-void CriticalPath::PushAvailableTask(Task* _task)
+// Claim a step of the task with the best priority; the task leaves the queue with its last step
+TaskState* Strategy::ClaimFront(ReadyQueue& _queue, int& _stepToProcess)
 {
-	/*Push tasks in EngineWorkQueues*/
-	if (_task->GetTaskType() == "engine")
+	SortQueue(_queue);
+	TaskState* task = _queue.Front();
+	if (task->HasFreeStepToProcess())
 	{
-		if (m_availableEngineTasks.empty())
-		{
-			m_availableEngineTasks.push_back(_task);
-		}
-		else
-		{
-			bool found = false;
-
-			std::vector<Task*>::iterator insertPos = m_availableEngineTasks.begin();
-			while (!found)
-			{
-				if (insertPos == m_availableEngineTasks.end())
-				{
-					m_availableEngineTasks.push_back(_task);
-					found = true;
-				}
-				else
-				{
-					if (IsOnCriticalPath(_task))
-					{
-						m_availableEngineTasks.insert(insertPos, _task);
-						found = true;
-					}
-
-					else if ((m_previousFrameinducedTime[*insertPos] <= m_previousFrameinducedTime[_task]) && !IsOnCriticalPath(*insertPos))
-					{
-						m_availableEngineTasks.insert(insertPos, _task);
-						found = true;
-					}
-
-					else
-					{
-						insertPos++;
-					}
-				}
-			}
-		}
+		_stepToProcess = task->ClaimFreeStep();
 	}
 
-	/*Push tasks into Graphic WorkQueues*/
+	if (!task->HasFreeStepToProcess())
+	{
+		_queue.PopFront();
+	}
 	else
 	{
-		if (m_availableGraphicTasks.empty())
-		{
-			m_availableGraphicTasks.push_back(_task);
-		}
-		else
-		{
-			bool found = false;
-
-			std::vector<Task*>::iterator insertPos = m_availableGraphicTasks.begin();
-			while (!found)
-			{
-				if (insertPos == m_availableGraphicTasks.end())
-				{
-					m_availableGraphicTasks.push_back(_task);
-					found = true;
-				}
-				else
-				{
-					if (IsOnCriticalPath(_task))
-					{
-						m_availableGraphicTasks.insert(insertPos, _task);
-						found = true;
-					}
-
-					else if ((m_previousFrameinducedTime[*insertPos] <= m_previousFrameinducedTime[_task]) && !IsOnCriticalPath(*insertPos))
-					{
-						m_availableGraphicTasks.insert(insertPos, _task);
-						found = true;
-					}
-
-					else
-					{
-						insertPos++;
-					}
-				}
-			}
-		}
+		_queue.FrontChanged();
 	}
-	AddTaskTime(_task);
+	return task;
 }
 
-//VARIANT CRITICAL PATH METHODS:
-
-//1- USING THE LONGEST STEP OF EACH TASK:
-void Strategy::FirstVariantInducedTime(Task* _task, double _inducedTime, std::vector<Task*> _criticalPath)
+void Strategy::SortQueue(ReadyQueue& _queue)
 {
-	std::vector<Task*> fathers = _task->GetFathers();
+	// The priorities can depend on the phase: read them all again when it changes
+	_queue.Sort([this](TaskState* _task) { return Priority(_task); }, IsDescending(_queue.Size()), m_phase);
+}
 
-	if (m_FirstVariantPrevious[_task] <= _inducedTime)
-	{
-		m_FirstVariantPrevious[_task] = _inducedTime;
-		_criticalPath.push_back(_task);
+bool Strategy::HasAvailableTask()
+{
+	return  (!m_availableEngineTasks.Empty() && !m_availableGraphicTasks.Empty());
+}
 
-		if (fathers.empty()) {
-			m_firstVariantCriticalPath = _criticalPath;
-			return;
-		}
+// Worker 0 also runs the graphic tasks; the other workers only run engine tasks
+bool Strategy::HasAvailableTaskFor(int _workerId)
+{
+	return !m_availableEngineTasks.Empty() || (_workerId == 0 && !m_availableGraphicTasks.Empty());
+}
 
-		for (std::vector<Task*>::iterator it = fathers.begin(); it != fathers.end(); it++)
-		{
-			AddTaskInducedTime(*it, m_FirstVariantPrevious[_task] + m_PreviousMaxStep[_task], _criticalPath);
-		}
-	}
-};
+double Strategy::GetBestTime()
+{
+	return m_bestTime;
+}
 
-bool firstVariantCriticalPath::IsOnCriticalPath(Task* _task) {
-	return (std::find(m_firstVariantCriticalPath.begin(), m_firstVariantCriticalPath.end(), _task) != m_firstVariantCriticalPath.end());
+bool Strategy::IsOnCriticalPath(const Task* _task) {
+	return (size_t)_task->GetIndex() < m_criticalPath.size() && m_criticalPath[_task->GetIndex()];
 }
 
-void firstVariantCriticalPath::PushAvailableTask(Task* _task)
+// Tasks on the critical path first, then the longest induced time first; the last pushed first on ties
+double CriticalPath::Priority(TaskState* task)
 {
-	/*Push tasks in EngineWorkQueues*/
-	if (_task->GetTaskType() == "engine")
+	if (IsOnCriticalPath(task->GetTask()))
 	{
-		if (m_availableEngineTasks.empty())
-		{
-			m_availableEngineTasks.push_back(_task);
-		}
-		else
-		{
-			bool found = false;
-
-			std::vector<Task*>::iterator insertPos = m_availableEngineTasks.begin();
-			while (!found)
-			{
-				if (insertPos == m_availableEngineTasks.end())
-				{
-					m_availableEngineTasks.push_back(_task);
-					found = true;
-				}
-				else
-				{
-					if (IsOnCriticalPath(_task))
-					{
-						m_availableEngineTasks.insert(insertPos, _task);
-						found = true;
-					}
-
-					else if ((m_FirstVariantPrevious[*insertPos] <= m_FirstVariantPrevious[_task]) && !IsOnCriticalPath(*insertPos))
-					{
-						m_availableEngineTasks.insert(insertPos, _task);
-						found = true;
-					}
-
-					else
-					{
-						insertPos++;
-					}
-				}
-			}
-		}
+		return std::numeric_limits<double>::infinity();
 	}
+	return m_previousFrameinducedTime[task->GetTask()->GetIndex()];
+}
 
-	/*Push tasks into Graphic WorkQueues*/
-	else
-	{
-		if (m_availableGraphicTasks.empty())
-		{
-			m_availableGraphicTasks.push_back(_task);
-		}
-		else
-		{
-			bool found = false;
+//VARIANT CRITICAL PATH METHODS:
 
-			std::vector<Task*>::iterator insertPos = m_availableGraphicTasks.begin();
-			while (!found)
-			{
-				if (insertPos == m_availableGraphicTasks.end())
-				{
-					m_availableGraphicTasks.push_back(_task);
-					found = true;
-				}
-				else
-				{
-					if (IsOnCriticalPath(_task))
-					{
-						m_availableGraphicTasks.insert(insertPos, _task);
-						found = true;
-					}
-
-					else if ((m_FirstVariantPrevious[*insertPos] <= m_FirstVariantPrevious[_task]) && !IsOnCriticalPath(*insertPos))
-					{
-						m_availableGraphicTasks.insert(insertPos, _task);
-						found = true;
-					}
-
-					else
-					{
-						insertPos++;
-					}
-				}
-			}
-		}
-	}
-	AddTaskTime(_task);
+//1- USING THE LONGEST STEP OF EACH TASK:
+bool firstVariantCriticalPath::IsOnCriticalPath(const Task* _task) {
+	return (size_t)_task->GetIndex() < m_firstVariantCriticalPath.size() && m_firstVariantCriticalPath[_task->GetIndex()];
 }
 
-//2- USING THE PROCESSING TIME OF EACH TASK:
-void Strategy::SecondVariantInducedTime(Task* _task, double _inducedTime, std::vector<Task*> _criticalPath)
+double firstVariantCriticalPath::Priority(TaskState* task)
 {
-	std::vector<Task*> fathers = _task->GetFathers();
-
-	if (m_SecondVariantPrevious[_task] <= _inducedTime)
+	if (IsOnCriticalPath(task->GetTask()))
 	{
-		m_SecondVariantPrevious[_task] = _inducedTime;
-		_criticalPath.push_back(_task);
-
-		if (fathers.empty()) {
-			m_secondVariantCriticalPath = _criticalPath;
-			return;
-		}
-
-		for (std::vector<Task*>::iterator it = fathers.begin(); it != fathers.end(); it++)
-		{
-			SecondVariantInducedTime(*it, m_SecondVariantPrevious[_task] + m_PreviousExecTime[_task], _criticalPath);
-		}
+		return std::numeric_limits<double>::infinity();
 	}
-};
+	return m_FirstVariantPrevious[task->GetTask()->GetIndex()];
+}
 
-bool secondVariantCriticalPath::IsOnCriticalPath(Task* _task) {
-	return (std::find(m_secondVariantCriticalPath.begin(), m_secondVariantCriticalPath.end(), _task) != m_secondVariantCriticalPath.end());
+//2- USING THE PROCESSING TIME OF EACH TASK:
+bool secondVariantCriticalPath::IsOnCriticalPath(const Task* _task) {
+	return (size_t)_task->GetIndex() < m_secondVariantCriticalPath.size() && m_secondVariantCriticalPath[_task->GetIndex()];
 }
 
-void secondVariantCriticalPath::PushAvailableTask(Task* _task)
+double secondVariantCriticalPath::Priority(TaskState* task)
 {
-	/*Push tasks in EngineWorkQueues*/
-	if (_task->GetTaskType() == "engine")
-	{
-		if (m_availableEngineTasks.empty())
-		{
-			m_availableEngineTasks.push_back(_task);
-		}
-		else
-		{
-			bool found = false;
-
-			std::vector<Task*>::iterator insertPos = m_availableEngineTasks.begin();
-			while (!found)
-			{
-				if (insertPos == m_availableEngineTasks.end())
-				{
-					m_availableEngineTasks.push_back(_task);
-					found = true;
-				}
-				else
-				{
-					if (IsOnCriticalPath(_task))
-					{
-						m_availableEngineTasks.insert(insertPos, _task);
-						found = true;
-					}
-
-					else if ((m_SecondVariantPrevious[*insertPos] <= m_SecondVariantPrevious[_task]) && !IsOnCriticalPath(*insertPos))
-					{
-						m_availableEngineTasks.insert(insertPos, _task);
-						found = true;
-					}
-
-					else
-					{
-						insertPos++;
-					}
-				}
-			}
-		}
-	}
-
-	/*Push tasks into Graphic WorkQueues*/
-	else
+	if (IsOnCriticalPath(task->GetTask()))
 	{
-		if (m_availableGraphicTasks.empty())
-		{
-			m_availableGraphicTasks.push_back(_task);
-		}
-		else
-		{
-			bool found = false;
-
-			std::vector<Task*>::iterator insertPos = m_availableGraphicTasks.begin();
-			while (!found)
-			{
-				if (insertPos == m_availableGraphicTasks.end())
-				{
-					m_availableGraphicTasks.push_back(_task);
-					found = true;
-				}
-				else
-				{
-					if (IsOnCriticalPath(_task))
-					{
-						m_availableGraphicTasks.insert(insertPos, _task);
-						found = true;
-					}
-
-					else if ((m_SecondVariantPrevious[*insertPos] <= m_SecondVariantPrevious[_task]) && !IsOnCriticalPath(*insertPos))
-					{
-						m_availableGraphicTasks.insert(insertPos, _task);
-						found = true;
-					}
-
-					else
-					{
-						insertPos++;
-					}
-				}
-			}
-		}
+		return std::numeric_limits<double>::infinity();
 	}
-	AddTaskTime(_task);
+	return m_SecondVariantPrevious[task->GetTask()->GetIndex()];
 }
 
 //////////////
@@ -503,7 +248,7 @@ void secondVariantCriticalPath::PushAvailableTask(Task* _task)
 NEH::NEH(const int _iNbWorkers)
 {
     m_workerCount = _iNbWorkers;
-	m_LessOrMore = "more";
+	m_LessOrMore = SortOrder::MORE;
     m_Workers.clear();
     for(int i=0;i<12;i++)
     {
@@ -540,9 +285,9 @@ double NEH::GetMakespan()
     }
     return max;
 };
-void NEH::FillWorkers(Task* _task)
+void NEH::FillWorkers(TaskState* _task)
 {
-    std::vector<double> Times=_task->GetTime();
+    std::vector<double> Times(_task->GetTimes(), _task->GetTimes() + _task->GetTimeCount());
     std::sort(Times.begin(), Times.end(), std::greater<double>());
     int pos=0;
     for(auto elem:Times)
@@ -552,7 +297,7 @@ void NEH::FillWorkers(Task* _task)
     }
 };
 
-double NEH::ScheduleTasks(std::vector<Task*> _tasks)
+double NEH::ScheduleTasks(std::vector<TaskState*> _tasks)
 {
     m_WorkersTest=m_Workers;
     for(int i=0;i<_tasks.size();i++)
@@ -574,12 +319,12 @@ double NEH::ScheduleTasks(std::vector<Task*> _tasks)
 void NEH::Transform()
 {
 	int cpt=0;
-	int size=m_availableEngineTasks.size();
-	Task* task=nullptr;
-	std::vector<Task*> Classed;
+	int size=m_engineTasks.size();
+	TaskState* task=nullptr;
+	std::vector<TaskState*> Classed;
 	while(cpt<size)
 	{
-		task=m_availableEngineTasks[cpt];
+		task=m_engineTasks[cpt];
 		if(Classed.empty())
 		{
 			Classed.push_back(task);
@@ -604,36 +349,35 @@ void NEH::Transform()
 		}
 		cpt++;
 	}
-	m_availableEngineTasks=Classed;
+	m_engineTasks=Classed;
 };
 
-Task* NEH::GetNextAvailableTask(int _workerId, int& _stepToProcess)
+void NEH::PushAvailableTask(TaskState* _task)
 {
-	Task* task = nullptr;
-	if (_workerId == 0)
+	if (_task->GetTask()->GetTaskType() == TaskType::ENGINE)
 	{
-		if (m_availableGraphicTasks.size() > 0)
-		{
-			bubbleSort(m_availableGraphicTasks);
-			task = m_availableGraphicTasks.front();
-			if (task != nullptr && task->HasFreeStepToProcess())
-			{
-				_stepToProcess = task->ClaimFreeStep();
-			}
+		m_engineTasks.push_back(_task);
+		AddTaskTime(_task);
+	}
+	else
+	{
+		Strategy::PushAvailableTask(_task);
+	}
+}
 
-			if (task == nullptr || !task->HasFreeStepToProcess())
-			{
-				m_availableGraphicTasks.erase(m_availableGraphicTasks.begin());
-			}
-			return task;
-		}
+TaskState* NEH::GetNextAvailableTask(int _workerId, int& _stepToProcess)
+{
+	TaskState* task = nullptr;
+	if (_workerId == 0 && !m_availableGraphicTasks.Empty())
+	{
+		return ClaimFront(m_availableGraphicTasks, _stepToProcess);
 	}
 
-	if (m_availableEngineTasks.size() > 0)
+	if (m_engineTasks.size() > 0)
 	{
-		bubbleSort(m_availableEngineTasks);
+		std::stable_sort(m_engineTasks.begin(), m_engineTasks.end(), [this](TaskState* _a, TaskState* _b) { return Priority(_a) > Priority(_b); });
 		Transform();
-		task = m_availableEngineTasks.front();
+		task = m_engineTasks.front();
 		if (task != nullptr && task->HasFreeStepToProcess())
 		{
 			_stepToProcess = task->ClaimFreeStep();
@@ -641,22 +385,27 @@ Task* NEH::GetNextAvailableTask(int _workerId, int& _stepToProcess)
 
 		if (task == nullptr || !task->HasFreeStepToProcess())
 		{
-			m_availableEngineTasks.erase(m_availableEngineTasks.begin());
+			m_engineTasks.erase(m_engineTasks.begin());
 		}
 	}
 
 	return task;
 }
 
-double ThreePhases::Priority(Task* task)
+bool NEH::HasAvailableTaskFor(int _workerId)
+{
+	return !m_engineTasks.empty() || (_workerId == 0 && !m_availableGraphicTasks.Empty());
+}
+
+double ThreePhases::Priority(TaskState* task)
 {
 	if(m_phase==0)
 	{
-		return task->GetLevel();
+		return task->GetTask()->GetLevel();
 	}
 	if(m_phase==1)
 	{
-		return task->GetHu();
+		return task->GetTask()->GetHu();
 	}
 	else
 	{
@@ -664,71 +413,90 @@ double ThreePhases::Priority(Task* task)
 	}
 };
 
-double TwoPhases::Priority(Task* task)
+double TwoPhases::Priority(TaskState* task)
 {
 	if(m_phase==0)
 	{
-		m_LessOrMore = "more";
-		return task->GetLevel();
+		return task->GetTask()->GetLevel();
 	}
 	else
 	{
-		m_LessOrMore = "less";
 		return task->GetResponseRatio();
 	}
 };
 
-double TwoPhasesStatic::Priority(Task* task)
+// The order is switched by the first sort of a queue of two tasks or more in a new phase:
+// that sort is still done with the previous order, except when going from the level to the ratio
+bool TwoPhases::IsDescending(size_t _queueSize)
+{
+	bool descending = (m_LessOrMore == SortOrder::MORE && m_phase == 0);
+	if (_queueSize > 1)
+	{
+		m_LessOrMore = (m_phase == 0) ? SortOrder::MORE : SortOrder::LESS;
+	}
+	return descending;
+}
+
+double TwoPhasesStatic::Priority(TaskState* task)
 {
 	if(m_phase==0)
 	{
-		return task->GetLevel();
+		return task->GetTask()->GetLevel();
 	}
 	else
 	{
-		return task->GetLabel();
+		return task->GetTask()->GetLabel();
 	}
 };
 
 //Infinity is a FIFO algorith scheduling executed with 1000 threads:
-Task* Infinity::GetNextAvailableTask(int _workerId, int& _stepToProcess)
+TaskState* Infinity::GetNextAvailableTask(int _workerId, int& _stepToProcess)
 {
-	Task* task = nullptr;
 	if (_workerId == 0)
 	{
-		if (m_availableGraphicTasks.size() > 0)
+		if (!m_availableGraphicTasks.Empty())
 		{
-			bubbleSort(m_availableGraphicTasks);
-			task = m_availableGraphicTasks.front();
-			if (task != nullptr && task->HasFreeStepToProcess())
-			{
-				_stepToProcess = task->ClaimFreeStep();
-			}
-
-			if (task == nullptr || !task->HasFreeStepToProcess())
-			{
-				m_availableGraphicTasks.erase(m_availableGraphicTasks.begin());
-			}
-			return task;
+			return ClaimFront(m_availableGraphicTasks, _stepToProcess);
 		}
 	}
-	else{
-	if (m_availableEngineTasks.size() > 0)
+	else if (!m_availableEngineTasks.Empty())
 	{
-		bubbleSort(m_availableEngineTasks);
-		
-		task = m_availableEngineTasks.front();
-		if (task != nullptr && task->HasFreeStepToProcess())
-		{
-			_stepToProcess = task->ClaimFreeStep();
-		}
-
-		if (task == nullptr || !task->HasFreeStepToProcess())
-		{
-			m_availableEngineTasks.erase(m_availableEngineTasks.begin());
-		}
-	}
+		return ClaimFront(m_availableEngineTasks, _stepToProcess);
 	}
 
-	return task;
+	return nullptr;
+}
+
+bool Infinity::HasAvailableTaskFor(int _workerId)
+{
+	return (_workerId == 0) ? !m_availableGraphicTasks.Empty() : !m_availableEngineTasks.Empty();
 }
+
+//METHOD NAMES OF THE INPUT FILE:
+//LPT, SPT, LRT, SRT AND NEH READ THE PROCESSING TIMES OF THE PREVIOUS FRAME, THE CRITICAL PATH STRATEGIES ITS
+//CRITICAL PATH AND ACO PLAYS IT AGAIN. LFF, HRRN, WT AND TWOPHASES READ THE FINISH AND WAITING TIMES OF ITS SCHEDULE
+REGISTER_STRATEGY("FIFO", FIFO, "first in first out", ANALYSIS_NONE, HISTORY_NONE);
+REGISTER_STRATEGY("Priority", CriticalPath, "dynamic critical path priority", ANALYSIS_NONE, HISTORY_PREVIOUS_FRAME);
+REGISTER_STRATEGY("LPT", LPT, "longest processing time first", ANALYSIS_NONE, HISTORY_PREVIOUS_FRAME);
+REGISTER_STRATEGY("SPT", SPT, "shortest processing time first", ANALYSIS_NONE, HISTORY_PREVIOUS_FRAME);
+REGISTER_STRATEGY("HLF", HLF, "Hu's level algorithm", ANALYSIS_LEVELS, HISTORY_NONE);
+REGISTER_STRATEGY("Hu", Hu, "Hu's level algorithm with the mean execution times", ANALYSIS_HU, HISTORY_NONE);
+REGISTER_STRATEGY("WL", WL, "weighted length", ANALYSIS_NONE, HISTORY_NONE);
+REGISTER_STRATEGY("LFF", LFF, "latest finished first", ANALYSIS_NONE, HISTORY_ALL);
+REGISTER_STRATEGY("HRRN", HRRN, "highest response ratio next", ANALYSIS_NONE, HISTORY_ALL);
+REGISTER_STRATEGY("MostSuccessors", MostScussors, "most successors first", ANALYSIS_NONE, HISTORY_NONE);
+REGISTER_STRATEGY("Coffman", Coffman, "Coffman-Graham algorithm", ANALYSIS_COFFMAN_LABELS, HISTORY_NONE);
+REGISTER_STRATEGY("LRT", LRT, "longest remaining time first", ANALYSIS_NONE, HISTORY_PREVIOUS_FRAME);
+REGISTER_STRATEGY("SRT", SRT, "shortest remaining time first", ANALYSIS_NONE, HISTORY_PREVIOUS_FRAME);
+REGISTER_STRATEGY("SLRT", SLRT, "step with the longest processing time first", ANALYSIS_NONE, HISTORY_NONE);
+REGISTER_STRATEGY("SSRT", SSRT, "step with the shortest processing time first", ANALYSIS_NONE, HISTORY_NONE);
+REGISTER_STRATEGY("Aco", Aco, "ant colony optimisation", ANALYSIS_COFFMAN_LABELS, HISTORY_PREVIOUS_FRAME);
+REGISTER_STRATEGY("firstVariantCriticalPath", firstVariantCriticalPath, "critical path of the longest steps", ANALYSIS_NONE, HISTORY_PREVIOUS_FRAME);
+REGISTER_STRATEGY("secondVariantCriticalPath", secondVariantCriticalPath, "critical path of the processing times", ANALYSIS_NONE, HISTORY_PREVIOUS_FRAME);
+REGISTER_STRATEGY("NEH", NEH, "Nawaz-Enscore-Ham insertion of the engine tasks", ANALYSIS_NONE, HISTORY_PREVIOUS_FRAME);
+REGISTER_STRATEGY("ThreePhases", ThreePhases, "level, then Hu's level, then step time", ANALYSIS_LEVELS | ANALYSIS_HU, HISTORY_NONE);
+REGISTER_STRATEGY("TwoPhases", TwoPhases, "level, then response ratio", ANALYSIS_LEVELS, HISTORY_ALL);
+REGISTER_STRATEGY("TwoPhasesStatic", TwoPhasesStatic, "level, then Coffman-Graham label", ANALYSIS_LEVELS | ANALYSIS_COFFMAN_LABELS, HISTORY_NONE);
+REGISTER_STRATEGY("WT", WT, "shortest waiting time first", ANALYSIS_NONE, HISTORY_ALL);
+// FIFO without a limit on the workers: its schedule is the critical path, computed without the workers
+REGISTER_CRITICAL_PATH_STRATEGY("Infinity", Infinity, "critical path with a single graphic thread", 1000);
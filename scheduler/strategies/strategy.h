@@ -2,254 +2,142 @@
 #include <map>
 #include <string>
 #include <vector>
-#include "../../tasks/task.h"
+#include "../../tasks/taskState.h"
+#include "readyQueue.h"
+
+//ORDER OF THE READY QUEUES: HIGHEST PRIORITY FIRST, LOWEST FIRST OR PUSH ORDER
+enum class SortOrder { MORE, LESS, OTHER };
 
 class Strategy
 {
 public:
-    void Initialize(Task* _lastTask, Task* _firstTask);
-    virtual void PushAvailableTask(Task* _task);
-    virtual Task* GetNextAvailableTask(int _workerId, int& _stepToProcess);
-	void AddTaskTime(Task* _task);
-	void AddTaskInducedTime(Task* _task, double _inducedTime, std::vector<Task*> _criticalPath);
+    Strategy();
+    //DELETED THROUGH Strategy* BY THE SCHEDULER AND THE CRITICAL PATH ENGINE
+    virtual ~Strategy() = default;
+    void Initialize(const Task* _lastTask, const Task* _firstTask, int _taskCount);
+    virtual void PushAvailableTask(TaskState* _task);
+    virtual TaskState* GetNextAvailableTask(int _workerId, int& _stepToProcess);
+	void AddTaskTime(TaskState* _task);
+	void ComputeInducedTimes(const Task* _lastTask, std::vector<double>& _execTime, std::vector<double>& _inducedTime, std::vector<bool>& _criticalPath);
     bool HasAvailableTask();
-	double GetBestTime(int _frameIndex);
-	virtual bool IsOnCriticalPath(Task* _task);
-	void bubbleSort(std::vector<Task*> &vec);
-	virtual double Priority(Task*) = 0;
-	double GetInducedTime(Task* task) { return m_previousFrameinducedTime[task]; };
-	void FirstVariantInducedTime(Task* _task, double _inducedTime, std::vector<Task*> _criticalPath);
-	void SecondVariantInducedTime(Task* _task, double _inducedTime, std::vector<Task*> _criticalPath);
+	virtual bool HasAvailableTaskFor(int _workerId);
+	//CRITICAL PATH LENGTH OF THE PREVIOUS FRAME, READ WHEN THE CURRENT FRAME STARTS
+	double GetBestTime();
+	virtual bool IsOnCriticalPath(const Task* _task);
+	virtual void SortQueue(ReadyQueue& _queue);
+	virtual bool IsDescending(size_t) { return m_LessOrMore == SortOrder::MORE; };
+	virtual double Priority(TaskState*) = 0;
+	double GetInducedTime(const Task* task) { return m_previousFrameinducedTime[task->GetIndex()]; };
 	//ThreePhase:
     void AddPhase(int _pahseNumber){m_phase=_pahseNumber;};
     int GetNumber(){return m_phase;};
 
 protected:
-	std::vector<Task*> m_availableEngineTasks;
-	std::vector<Task*> m_availableGraphicTasks;
-	std::vector<Task*> m_criticalPath;
-	int m_phase;
-
-	std::vector<Task*> m_firstVariantCriticalPath;
-	std::vector<Task*> m_secondVariantCriticalPath;
-
-	std::map<Task*,double> m_PreviousExecTime;
-	std::map<Task*,double> m_PreviousMaxStep;
-
-	std::map<Task*, double> m_previousFrameExecTime;
-	std::map<Task*, double> m_previousFrameinducedTime;
-	std::map<Task*, double> m_FirstVariantPrevious;
-	std::map<Task*, double> m_SecondVariantPrevious;
-	std::vector<double> m_bestTime;
-	std::string m_LessOrMore;
-	int m_workerCount;
-	bool m_tie_break;
-};
-
-class LPT : public Strategy
-{
-public:
-	LPT(const int _iNbWorkers) {
-		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "more";
-	};
-
-	~LPT() {};
-	double Priority(Task* task) { return task->GetPT(); };	
-};
-
-
-class SPT : public Strategy
-{
-public:
-	SPT(const int _iNbWorkers) {
-		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "less";
-	};
-
-	~SPT() {};
-	double Priority(Task* task) { return task->GetPT(); };
-};
-
-class Aco : public Strategy
-{
-public:
-	Aco(const int _iNbWorkers) {
-		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "less";
-	};
-
-	~Aco() {};
-	double Priority(Task* task) { return task->GetAnt(); };
-};
-
-class HLF : public Strategy
-{
-public:
-	HLF(const int _iNbWorkers) {
-		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "more";
-		m_tie_break=true;
-	};
-
-	~HLF() {};
-	double Priority(Task* task) { return task->GetLevel(); };
-};
-
-class Hu : public Strategy
-{
-public:
-	Hu(const int _iNbWorkers) {
-		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "more";
-	};
-
-	~Hu() {};
-	double Priority(Task* task) { return task->GetHu(); };
-};
-
-
-class WL : public Strategy
-{
-public:
-	WL(const int _iNbWorkers) {
-		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "more";
-	};
-
-	~WL() {};
-	double Priority(Task* task) { return task->GetWl(); };
-};
-
-class LFF : public Strategy
-{
-public:
-	LFF(const int _iNbWorkers) {
-		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "less";
-	};
-
-	~LFF() {};
-	double Priority(Task* task) { return task->GetFT(); };
-};
-
-class HRRN: public Strategy
-{
-public:
-	HRRN(const int _iNbWorkers) {
-		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "less";
-	};
-
-	~HRRN() {};
-	double Priority(Task* task) { return task->GetResponseRatio(); };
-};
-
-class MostScussors : public Strategy
-{
-public:
-	MostScussors(const int _iNbWorkers) {
-		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "more";
-	};
-
-	~MostScussors() {};
-	double Priority(Task* task) { return task->GetSons().size(); };
-};
+	TaskState* ClaimFront(ReadyQueue& _queue, int& _stepToProcess);
 
-class Coffman : public Strategy
-{
-public:
-	Coffman(const int _iNbWorkers) {
-		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "more";
-	};
+	ReadyQueue m_availableEngineTasks;
+	ReadyQueue m_availableGraphicTasks;
+	void AddFathersFirst(const Task* _task, std::vector<bool>& _visited);
 
-	~Coffman() {};
-	double Priority(Task* task) { return task->GetLabel(); };
-};
+	//TASKS LEADING TO THE LAST TASK, EACH ONE AFTER ITS FATHERS
+	std::vector<const Task*> m_fathersFirst;
+	int m_taskCount;
 
-class TOPO : public Strategy
-{
-public:
-	TOPO(const int _iNbWorkers) {
-		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "less";
-	};
-
-	~TOPO() {};
-	double Priority(Task* task) { return task->GetTopoOrder(); };
-};
-
-class LRT : public Strategy
-{
-public:
-	LRT(const int _iNbWorkers) {
-		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "more";
-	};
-
-	~LRT() {};
-	double Priority(Task* task) { return task->GetRemainingPreviousTime(); };
-};
-
-class SRT : public Strategy
-{
-public:
-	SRT(const int _iNbWorkers) {
-		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "less";
-	};
+	//ON CRITICAL PATH FLAGS, BY TASK INDEX
+	std::vector<bool> m_criticalPath;
+	int m_phase;
 
-	~SRT() {};
-	double Priority(Task* task) { return task->GetRemainingPreviousTime(); };
-};
+	std::vector<bool> m_firstVariantCriticalPath;
+	std::vector<bool> m_secondVariantCriticalPath;
 
-class SLRT : public Strategy
-{
-public:
-	SLRT(const int _iNbWorkers) {
-		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "more";
-	};
+	//TIMES OF THE PREVIOUS FRAME, BY TASK INDEX
+	bool m_hasPreviousFrame;
+	std::vector<double> m_PreviousExecTime;
+	std::vector<double> m_PreviousMaxStep;
 
-	~SLRT() {};
-	double Priority(Task* task) { return task->GetRemainingTimeForStep(task->GetCurrentStep()); };
+	std::vector<double> m_previousFrameExecTime;
+	std::vector<double> m_previousFrameinducedTime;
+	std::vector<double> m_FirstVariantPrevious;
+	std::vector<double> m_SecondVariantPrevious;
+	double m_bestTime;
+	SortOrder m_LessOrMore;
+	int m_workerCount;
 };
 
-class SSRT : public Strategy
-{
-public:
-	SSRT(const int _iNbWorkers) {
-		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "less";
-	};
-
-	~SSRT() {};
-	double Priority(Task* task) { return task->GetRemainingTimeForStep(task->GetCurrentStep()); };
-};
+// Strategy ordering the ready tasks by a priority key read from the task only, the first pushed
+// first on ties. The key and the order are template parameters: each strategy gets its own
+// sort of the ready queues, with the key and the comparisons inlined.
+template <class KEY, SortOrder ORDER>
+class PolicyStrategy : public Strategy
+{
+public:
+	PolicyStrategy(const int _iNbWorkers) {
+		m_workerCount = _iNbWorkers;
+		m_LessOrMore = ORDER;
+	};
+
+	double Priority(TaskState* task) override { return KEY::Get(task); };
+	bool IsDescending(size_t) override { return ORDER == SortOrder::MORE; };
+	void SortQueue(ReadyQueue& _queue) override { _queue.Sort<ORDER == SortOrder::MORE>([](TaskState* _task) { return KEY::Get(_task); }, m_phase); };
+};
+
+//PRIORITY KEYS
+struct NoKey { static double Get(TaskState*) { return 0.0; }; };
+struct ProcessingTimeKey { static double Get(TaskState* _task) { return _task->GetPT(); }; };
+struct AntKey { static double Get(TaskState* _task) { return _task->GetAnt(); }; };
+struct LevelKey { static double Get(TaskState* _task) { return _task->GetTask()->GetLevel(); }; };
+struct HuKey { static double Get(TaskState* _task) { return _task->GetTask()->GetHu(); }; };
+struct WeightedLengthKey { static double Get(TaskState* _task) { return _task->GetTask()->GetWl(); }; };
+struct FinishTimeKey { static double Get(TaskState* _task) { return _task->GetFT(); }; };
+struct ResponseRatioKey { static double Get(TaskState* _task) { return _task->GetResponseRatio(); }; };
+struct SuccessorsKey { static double Get(TaskState* _task) { return _task->GetTask()->GetSons().size(); }; };
+struct LabelKey { static double Get(TaskState* _task) { return _task->GetTask()->GetLabel(); }; };
+struct TopoOrderKey { static double Get(TaskState* _task) { return _task->GetTask()->GetTopoOrder(); }; };
+struct RemainingPreviousTimeKey { static double Get(TaskState* _task) { return _task->GetRemainingPreviousTime(); }; };
+struct StepTimeKey { static double Get(TaskState* _task) { return _task->GetRemainingTimeForStep(_task->GetCurrentStep()); }; };
+struct WaitingTimeKey { static double Get(TaskState* _task) { return _task->GetWaitingTime(); }; };
+
+//FIRST IN FIRST OUT
+typedef PolicyStrategy<NoKey, SortOrder::OTHER> FIFO;
+//LONGEST AND SHORTEST PROCESSING TIME (PREVIOUS FRAME) FIRST
+typedef PolicyStrategy<ProcessingTimeKey, SortOrder::MORE> LPT;
+typedef PolicyStrategy<ProcessingTimeKey, SortOrder::LESS> SPT;
+//ORDER CHOSEN BY THE ANT COLONY
+typedef PolicyStrategy<AntKey, SortOrder::LESS> Aco;
+//HU'S LEVEL, WITH THE MEAN EXECUTION TIMES FOR Hu
+typedef PolicyStrategy<LevelKey, SortOrder::MORE> HLF;
+typedef PolicyStrategy<HuKey, SortOrder::MORE> Hu;
+//WEIGHTED LENGTH
+typedef PolicyStrategy<WeightedLengthKey, SortOrder::MORE> WL;
+//LATEST FINISHED FIRST
+typedef PolicyStrategy<FinishTimeKey, SortOrder::LESS> LFF;
+//HIGHEST RESPONSE RATIO NEXT
+typedef PolicyStrategy<ResponseRatioKey, SortOrder::LESS> HRRN;
+//MOST SUCCESSORS FIRST
+typedef PolicyStrategy<SuccessorsKey, SortOrder::MORE> MostScussors;
+//COFFMAN GRAHAM LABELS
+typedef PolicyStrategy<LabelKey, SortOrder::MORE> Coffman;
+//TOPOLOGICAL ORDER
+typedef PolicyStrategy<TopoOrderKey, SortOrder::LESS> TOPO;
+//LONGEST AND SHORTEST REMAINING TIME FIRST
+typedef PolicyStrategy<RemainingPreviousTimeKey, SortOrder::MORE> LRT;
+typedef PolicyStrategy<RemainingPreviousTimeKey, SortOrder::LESS> SRT;
+//STEP WITH THE LONGEST AND SHORTEST PROCESSING TIME FIRST
+typedef PolicyStrategy<StepTimeKey, SortOrder::MORE> SLRT;
+typedef PolicyStrategy<StepTimeKey, SortOrder::LESS> SSRT;
+//SHORTEST WAITING TIME (PREVIOUS FRAME) FIRST
+typedef PolicyStrategy<WaitingTimeKey, SortOrder::LESS> WT;
 
 class CriticalPath : public Strategy
 {
 public:
 	CriticalPath(const int _iNbWorkers) {
 		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "other";
-	};
-	void PushAvailableTask(Task* _task) override;
-	double Priority(Task* task) { return 0.0; };
-};
-
-class FIFO : public Strategy
-{
-public:
-	FIFO(const int _iNbWorkers) {
-		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "other";
+		m_LessOrMore = SortOrder::MORE;
+		m_availableEngineTasks.SetNewestFirst(true);
+		m_availableGraphicTasks.SetNewestFirst(true);
 	};
-
-	~FIFO() {};
-	double Priority(Task* task) { return 0.0; };
+	double Priority(TaskState* task);
 };
 
 class firstVariantCriticalPath : public Strategy
@@ -257,11 +145,12 @@ class firstVariantCriticalPath : public Strategy
 public:
 	firstVariantCriticalPath(const int _iNbWorkers) {
 		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "other";
+		m_LessOrMore = SortOrder::MORE;
+		m_availableEngineTasks.SetNewestFirst(true);
+		m_availableGraphicTasks.SetNewestFirst(true);
 	};
-	bool IsOnCriticalPath(Task* _task)  override;
-	void PushAvailableTask(Task* _task) override;
-	double Priority(Task* task) { return 0.0; };
+	bool IsOnCriticalPath(const Task* _task) override;
+	double Priority(TaskState* task);
 };
 
 class secondVariantCriticalPath : public Strategy
@@ -269,26 +158,31 @@ class secondVariantCriticalPath : public Strategy
 public:
 	secondVariantCriticalPath(const int _iNbWorkers) {
 		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "other";
+		m_LessOrMore = SortOrder::MORE;
+		m_availableEngineTasks.SetNewestFirst(true);
+		m_availableGraphicTasks.SetNewestFirst(true);
 	};
-	bool IsOnCriticalPath(Task* _task) override;
-	void PushAvailableTask(Task* _task) override;
-	double Priority(Task* task) { return 0.0; };
+	bool IsOnCriticalPath(const Task* _task) override;
+	double Priority(TaskState* task);
 };
 
 class NEH:public Strategy
 {
 public:
     NEH(const int _iNbWorkers);
-    std::vector<Task*> Sort(std::vector<Task*> _tasks);
+    std::vector<TaskState*> Sort(std::vector<TaskState*> _tasks);
     int GetAvailableWorker();
     double GetMakespan();
-    void FillWorkers(Task* _task);
-    double ScheduleTasks(std::vector<Task*> _tasks);
-    double Priority(Task* task) { return task->GetPT(); };
-	Task* GetNextAvailableTask(int _workerId, int& _stepToProcess);
+    void FillWorkers(TaskState* _task);
+    double ScheduleTasks(std::vector<TaskState*> _tasks);
+    double Priority(TaskState* task) { return task->GetPT(); };
+	void PushAvailableTask(TaskState* _task) override;
+	TaskState* GetNextAvailableTask(int _workerId, int& _stepToProcess);
+	bool HasAvailableTaskFor(int _workerId) override;
 	void Transform();
 private:
+	//THE ENGINE TASKS ARE ALL ORDERED AGAIN AT EACH DISPATCH
+	std::vector<TaskState*> m_engineTasks;
     std::map<int,double> m_Workers;
     std::map<int,double> m_WorkersTest;
 };
@@ -298,22 +192,23 @@ class ThreePhases:public Strategy
 	public:
 	ThreePhases(const int _iNbWorkers){
 		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "more";
+		m_LessOrMore = SortOrder::MORE;
 	};
 
 	~ThreePhases() {};
-	double Priority(Task* task);
+	double Priority(TaskState* task);
 };
 class TwoPhases:public Strategy
 {
 	public:
 	TwoPhases(const int _iNbWorkers){
 		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "more";
+		m_LessOrMore = SortOrder::MORE;
 	};
 
 	~TwoPhases() {};
-	double Priority(Task* task);
+	bool IsDescending(size_t _queueSize) override;
+	double Priority(TaskState* task);
 };
 
 class TwoPhasesStatic:public Strategy
@@ -321,23 +216,11 @@ class TwoPhasesStatic:public Strategy
 	public:
 	TwoPhasesStatic(const int _iNbWorkers){
 		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "more";
+		m_LessOrMore = SortOrder::MORE;
 	};
 
 	~TwoPhasesStatic() {};
-	double Priority(Task* task);
-};
-
-class WT: public Strategy
-{
-public:
-	WT(const int _iNbWorkers) {
-		m_workerCount = _iNbWorkers;
-		m_LessOrMore = "less";
-	};
-
-	~WT() {};
-	double Priority(Task* task) { return task->GetWaitingTime(); };
+	double Priority(TaskState* task);
 };
 
 class Infinity : public Strategy
@@ -345,10 +228,11 @@ class Infinity : public Strategy
 public:
 	Infinity(const int _iNbWorkers) {
 		m_workerCount =_iNbWorkers;
-		m_LessOrMore = "other";
+		m_LessOrMore = SortOrder::OTHER;
 	};
 
 	~Infinity() {};
-	Task* GetNextAvailableTask(int _workerId, int& _stepToProcess) override;
-	double Priority(Task* task) { return 0.0; };
+	TaskState* GetNextAvailableTask(int _workerId, int& _stepToProcess) override;
+	bool HasAvailableTaskFor(int _workerId) override;
+	double Priority(TaskState* task) { return 0.0; };
 };
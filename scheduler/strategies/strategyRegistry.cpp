@@ -0,0 +1,47 @@
+#include <stdafx.h>
+
+#include "strategyRegistry.h"
+
+// Built on first use: the strategies register during static initialization, in any order
+std::map<std::string, StrategyInfo>& StrategyRegistry::GetStrategies()
+{
+	static std::map<std::string, StrategyInfo> strategies;
+	return strategies;
+}
+
+bool StrategyRegistry::Register(const StrategyInfo& _info)
+{
+	return GetStrategies().insert(std::make_pair(_info.m_name, _info)).second;
+}
+
+const StrategyInfo* StrategyRegistry::Find(const std::string& _name)
+{
+	std::map<std::string, StrategyInfo>::const_iterator it = GetStrategies().find(_name);
+	return (it != GetStrategies().end()) ? &it->second : nullptr;
+}
+
+Strategy* StrategyRegistry::Create(const std::string& _name, int _nbWorkers)
+{
+	const StrategyInfo* info = Find(_name);
+	return (info != nullptr) ? info->m_factory(_nbWorkers) : nullptr;
+}
+
+std::vector<std::string> StrategyRegistry::GetNames()
+{
+	std::vector<std::string> names;
+	for (const auto& elem : GetStrategies())
+	{
+		names.push_back(elem.first);
+	}
+	return names;
+}
+
+int StrategyRegistry::GetAnalyses(const std::vector<std::string>& _methods)
+{
+	int analyses = ANALYSIS_NONE;
+	for (const std::string& method : _methods)
+	{
+		analyses |= Find(method)->m_analyses;
+	}
+	return analyses;
+}
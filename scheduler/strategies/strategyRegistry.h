@@ -0,0 +1,64 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+class Strategy;
+
+//GRAPH ANALYSES READ BY THE STRATEGIES: ONLY THOSE OF THE SELECTED METHODS ARE COMPUTED
+enum GraphAnalysis
+{
+	ANALYSIS_NONE = 0,
+	ANALYSIS_COFFMAN_LABELS = 1, // SimulationUtils::LexicographicalSorting
+	ANALYSIS_HU = 2,             // SimulationUtils::HU
+	ANALYSIS_LEVELS = 4          // SimulationUtils::HLF
+};
+
+//PREVIOUS FRAMES READ BY THE PRIORITIES OF A STRATEGY: ALL OF THEM WHEN THEY READ THE SCHEDULE OF THE
+//PREVIOUS FRAME, WHICH DEPENDS ON THE FRAME BEFORE IT
+const int HISTORY_NONE = 0;
+const int HISTORY_PREVIOUS_FRAME = 1;
+const int HISTORY_ALL = -1;
+
+// What the runner needs to know about a strategy before building it
+struct StrategyInfo
+{
+	std::string m_name;              // method name of the input file
+	std::function<Strategy*(int)> m_factory;
+	std::string m_description;       // listed with the names when a method is unknown
+	int m_analyses;                  // GraphAnalysis flags
+	int m_historyFrames;             // previous frames whose times the priorities read, or HISTORY_ALL
+	int m_fixedWorkers;              // number of workers used whatever the input (0: the input ones)
+	bool m_criticalPath;             // computed by CriticalPathEngine instead of simulated
+};
+
+// Strategies by method name. Each strategy registers itself next to its definition with
+// REGISTER_STRATEGY, so adding one does not touch the scheduler or the runner.
+class StrategyRegistry
+{
+public:
+	static bool Register(const StrategyInfo& _info);
+
+	//NULL FOR AN UNKNOWN NAME
+	static const StrategyInfo* Find(const std::string& _name);
+	static Strategy* Create(const std::string& _name, int _nbWorkers);
+
+	//ALL THE NAMES, IN ALPHABETICAL ORDER
+	static std::vector<std::string> GetNames();
+
+	//GRAPH ANALYSES NEEDED BY ALL THE METHODS: THE METHODS MUST BE KNOWN
+	static int GetAnalyses(const std::vector<std::string>& _methods);
+
+private:
+	static std::map<std::string, StrategyInfo>& GetStrategies();
+};
+
+//STRATEGY SIMULATED ON THE WORKERS OF THE INPUT FILE
+#define REGISTER_STRATEGY(NAME, CLASS, DESCRIPTION, ANALYSES, HISTORY_FRAMES) \
+	static const bool s_registered##CLASS = StrategyRegistry::Register({ NAME, [](int _nbWorkers) -> Strategy* { return new CLASS(_nbWorkers); }, DESCRIPTION, ANALYSES, HISTORY_FRAMES, 0, false })
+
+//STRATEGY WHOSE SCHEDULE IS THE CRITICAL PATH, COMPUTED BY CriticalPathEngine FOR _WORKERS WORKERS
+#define REGISTER_CRITICAL_PATH_STRATEGY(NAME, CLASS, DESCRIPTION, WORKERS) \
+	static const bool s_registered##CLASS = StrategyRegistry::Register({ NAME, [](int _nbWorkers) -> Strategy* { return new CLASS(_nbWorkers); }, DESCRIPTION, ANALYSIS_NONE, HISTORY_NONE, WORKERS, true })
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+
+// Counter-based random numbers (Philox4x32-10): the numbers drawn for a counter only depend on
+// the key and on that counter, so the samples can be drawn in any order and on any thread.
+// Counters are (step, task index, frame, stream) and the key is the RNG seed.
+class CounterRng
+{
+public:
+	enum Stream : uint32_t
+	{
+		EXECUTION_TIME = 0,
+		LAG = 1,
+		LATIN_HYPERCUBE_PERMUTATION = 2,
+		LONGEST_STEP = 3
+	};
+
+	//NUMBER OF CONSECUTIVE STEPS DRAWN BY UniformBatch
+	static const int BATCH = 8;
+
+	CounterRng(uint32_t _seed) : m_seed(_seed) {};
+
+	//TWO UNIFORM NUMBERS IN ]0,1[ FOR A COUNTER
+	void Uniforms(uint32_t _step, uint32_t _task, uint32_t _frame, uint32_t _stream, double& _u1, double& _u2) const
+	{
+		uint32_t counter[4] = { _step, _task, _frame, _stream };
+		uint32_t key0 = m_seed;
+		uint32_t key1 = KEY1;
+		for (int round = 0; round < 10; round++)
+		{
+			Round(counter[0], counter[1], counter[2], counter[3], key0, key1);
+			key0 += BUMP0;
+			key1 += BUMP1;
+		}
+		_u1 = ToUnit(counter[0], counter[1]);
+		_u2 = ToUnit(counter[2], counter[3]);
+	}
+
+	double Uniform(uint32_t _step, uint32_t _task, uint32_t _frame, uint32_t _stream) const
+	{
+		double u1, u2;
+		Uniforms(_step, _task, _frame, _stream, u1, u2);
+		return u1;
+	}
+
+	//SAME NUMBERS AS Uniforms FOR STEPS _firstStep TO _firstStep+BATCH-1, ALL THE STEPS AT ONCE:
+	//THE LOOPS OVER THE STEPS ARE WRITTEN TO BE VECTORIZED
+	void UniformBatch(uint32_t _firstStep, uint32_t _task, uint32_t _frame, uint32_t _stream, double* _u1, double* _u2) const
+	{
+		for (int k = 0; k < BATCH; k++)
+		{
+			uint32_t counter[4] = { _firstStep + k, _task, _frame, _stream };
+			uint32_t key0 = m_seed;
+			uint32_t key1 = KEY1;
+			for (int round = 0; round < 10; round++)
+			{
+				Round(counter[0], counter[1], counter[2], counter[3], key0, key1);
+				key0 += BUMP0;
+				key1 += BUMP1;
+			}
+			_u1[k] = ToUnit(counter[0], counter[1]);
+			_u2[k] = ToUnit(counter[2], counter[3]);
+		}
+	}
+
+private:
+	static const uint32_t KEY1 = 0x5EED5EED;
+	static const uint32_t BUMP0 = 0x9E3779B9;
+	static const uint32_t BUMP1 = 0xBB67AE85;
+
+	static void Round(uint32_t& _c0, uint32_t& _c1, uint32_t& _c2, uint32_t& _c3, uint32_t _key0, uint32_t _key1)
+	{
+		// Low and high halves of the products are computed apart: the loops over the steps vectorize
+		uint32_t c0 = _c0;
+		uint32_t c2 = _c2;
+		uint32_t high0 = (uint32_t)(((uint64_t)c0 * 0xD2511F53u) >> 32);
+		uint32_t high2 = (uint32_t)(((uint64_t)c2 * 0xCD9E8D57u) >> 32);
+		_c0 = high2 ^ _c1 ^ _key0;
+		_c2 = high0 ^ _c3 ^ _key1;
+		_c1 = c2 * 0xCD9E8D57u;
+		_c3 = c0 * 0xD2511F53u;
+	}
+
+	// 53 random bits (27 + 26), centered in their interval so that 0 and 1 are never returned
+	static double ToUnit(uint32_t _high, uint32_t _low)
+	{
+		return ((double)(int32_t)(_high >> 5) * 67108864.0 + (double)(int32_t)(_low >> 6) + 0.5) / 9007199254740992.0;
+	}
+
+	uint32_t m_seed;
+};
@@ -0,0 +1,192 @@
+#include <stdafx.h>
+#include <fstream>
+#include <deque>
+#include <queue>
+
+#include "criticalPathEngine.h"
+#include "frameStream.h"
+#include "frameBounds.h"
+#include "steadyState.h"
+#include "scheduler/strategies/strategy.h"
+#include "scheduler/strategies/strategyRegistry.h"
+#include "tasks/keytasks.h"
+
+FrameMetrics CriticalPathEngine::Play(SimulationParameters& _parameters, std::string Strategy, int _nbThreads)
+{
+	// The strategy only gives the estimate of the critical path of the previous frame
+	::Strategy* strategy = StrategyRegistry::Create(Strategy, _parameters.m_iNbWorkers);
+	SequenceState state(_parameters.m_sequence);
+	state.WichToAssign(_parameters.mode);
+
+	// Tasks ready together are pushed from the last name to the first, as in Scheduler::Update
+	std::vector<int> nameRank(_parameters.m_sequence.GetTasks().size());
+	int rank = 0;
+	for (int index : _parameters.m_sequence.GetIndicesByName())
+	{
+		nameRank[index] = rank++;
+	}
+
+	std::ofstream myfile(Simulation::GetResultFile(_parameters, Strategy, "TXT", ".txt"));
+	FrameStream frames(_parameters, _nbThreads);
+	FrameBounds bounds(_parameters.m_sequence, _parameters.m_iNbWorkers);
+	FrameMetrics metrics;
+	metrics.m_weighted = _parameters.ImportanceShift != 0.0;
+	SteadyState steady(_parameters);
+	double clockTime = 0.0;
+	for (int i = 0; i < _parameters.m_iNbFrames; i++)
+	{
+		frames.Load(i);
+		Simulation::BindFrame(_parameters, frames, state, i);
+		double startTime = clockTime;
+		clockTime = PlayFrame(_parameters, state, strategy, nameRank, startTime, frames.GetLag(i));
+		myfile << i << " " << clockTime - startTime << " " << strategy->GetBestTime() << " " << frames.GetLag(i);
+		if (_parameters.BoundsOutput)
+		{
+			bounds.Compute(state);
+			bounds.Write(myfile, clockTime - startTime);
+		}
+		double weight = (_parameters.ImportanceShift != 0.0) ? Simulation::GetFrameWeight(frames, i, StrategyRegistry::Find(Strategy)->m_historyFrames) : 1.0;
+		if (_parameters.ImportanceShift != 0.0)
+		{
+			myfile << " " << weight;
+		}
+		myfile << std::endl;
+		metrics.Add(clockTime - startTime, weight);
+		if (_parameters.SteadyStateOutput && steady.Add(frames.GetLag(i), clockTime - startTime, weight))
+		{
+			break;
+		}
+	}
+	myfile.close();
+	if (_parameters.SteadyStateOutput)
+	{
+		steady.Write(Simulation::GetResultFile(_parameters, Strategy, "Steady", ".txt"));
+		metrics = steady.Estimate(metrics);
+	}
+	delete strategy;
+	return metrics;
+}
+
+double CriticalPathEngine::PlayFrame(SimulationParameters& _parameters, SequenceState& _state, Strategy* _strategy, const std::vector<int>& _nameRank, double _startTime, double _lagProportion)
+{
+	TaskSequence& sequence = _parameters.m_sequence;
+	const std::vector<Task*>& tasks = sequence.GetTasks();
+	_strategy->Initialize(sequence.GetTask(END_TASK), sequence.GetTask(INIT_TASK), tasks.size());
+
+	std::vector<int> remainingFathers(tasks.size(), 0);
+	std::vector<bool> doneAtStart(tasks.size(), false);
+	for (Task* task : tasks)
+	{
+		_state.GetState(task)->Initialize(_lagProportion);
+		for (Task* son : task->GetSons())
+		{
+			remainingFathers[son->GetIndex()]++;
+		}
+	}
+
+	// A task without any time to spend this frame is already done: its sons do not wait for it
+	std::vector<Task*> readyTasks;
+	for (int index : sequence.GetIndicesByName())
+	{
+		if (remainingFathers[index] == 0)
+		{
+			readyTasks.push_back(tasks[index]);
+		}
+	}
+	for (int index : sequence.GetIndicesByName())
+	{
+		doneAtStart[index] = _state.GetState(tasks[index])->IsDone();
+		if (doneAtStart[index])
+		{
+			for (Task* son : tasks[index]->GetSons())
+			{
+				if (--remainingFathers[son->GetIndex()] == 0)
+				{
+					readyTasks.push_back(son);
+				}
+			}
+		}
+	}
+
+	// End of the tasks by time; on ties the graphic thread first, as worker 0 is
+	struct End
+	{
+		double m_time;
+		bool m_engine;
+		long long m_order;
+		Task* m_task;
+		bool operator<(const End& _end) const
+		{
+			if (m_time != _end.m_time)
+			{
+				return m_time > _end.m_time;
+			}
+			if (m_engine != _end.m_engine)
+			{
+				return m_engine;
+			}
+			return m_order > _end.m_order;
+		}
+	};
+	std::priority_queue<End> ends;
+	long long order = 0;
+	std::deque<Task*> graphicTasks;
+	bool graphicThreadIdle = true;
+
+	auto pushReadyTasks = [&](double _time)
+	{
+		std::sort(readyTasks.begin(), readyTasks.end(), [&](Task* _a, Task* _b) { return _nameRank[_a->GetIndex()] > _nameRank[_b->GetIndex()]; });
+		for (Task* task : readyTasks)
+		{
+			TaskState* state = _state.GetState(task);
+			_strategy->AddTaskTime(state);
+			if (task->GetTaskType() == TaskType::GRAPHIC)
+			{
+				graphicTasks.push_back(task);
+			}
+			else
+			{
+				// All the steps start now: the task ends with its longest step
+				ends.push({ _time + state->GetStartLongestTime(), true, order++, task });
+			}
+		}
+		readyTasks.clear();
+
+		if (graphicThreadIdle && !graphicTasks.empty())
+		{
+			// The steps of a graphic task run one after the other
+			Task* task = graphicTasks.front();
+			graphicTasks.pop_front();
+			TaskState* state = _state.GetState(task);
+			double end = _time;
+			for (int step = 0; step < state->GetStepCount(); step++)
+			{
+				end = end + state->GetRemainingTimeForStep(step);
+			}
+			ends.push({ end, false, order++, task });
+			graphicThreadIdle = false;
+		}
+	};
+
+	double clockTime = _startTime;
+	pushReadyTasks(clockTime);
+	while (!ends.empty())
+	{
+		End end = ends.top();
+		ends.pop();
+		clockTime = end.m_time;
+		graphicThreadIdle = graphicThreadIdle || !end.m_engine;
+		if (!doneAtStart[end.m_task->GetIndex()])
+		{
+			for (Task* son : end.m_task->GetSons())
+			{
+				if (--remainingFathers[son->GetIndex()] == 0)
+				{
+					readyTasks.push_back(son);
+				}
+			}
+		}
+		pushReadyTasks(clockTime);
+	}
+	return clockTime;
+}
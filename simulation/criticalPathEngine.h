@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "simulation.h"
+
+class Strategy;
+
+// Schedule of the Infinity method computed directly from the step times, without simulating
+// its workers. With as many workers as steps, an engine task runs all its steps at once as soon
+// as it is ready and ends after its longest step; the graphic tasks still share the graphic
+// thread, one after the other in the order they became ready, each step after the previous one.
+// The tasks are visited in the order they end: the frame costs O((V + E) log V) instead of an
+// event loop over 1000 workers, and the frame durations and estimates are those of Simulation::Play.
+class CriticalPathEngine
+{
+public:
+	// Same result file and metrics as Simulation::Play; no Json trace is written
+	static FrameMetrics Play(SimulationParameters& _parameters, std::string Strategy, int _nbThreads = 1);
+
+private:
+	//END TIME OF A FRAME STARTING AT _startTime, THE TASKS BOUND TO THE TIMES OF THE FRAME
+	static double PlayFrame(SimulationParameters& _parameters, SequenceState& _state, Strategy* _strategy, const std::vector<int>& _nameRank, double _startTime, double _lagProportion);
+};
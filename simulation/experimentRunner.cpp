@@ -0,0 +1,558 @@
+#include <stdafx.h>
+#include <map>
+#include <set>
+#include <tuple>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include "experimentRunner.h"
+#include "simulationUtils.h"
+#include "sampleCache.h"
+#include "criticalPathEngine.h"
+#include "statistics.h"
+#include "metricsSummary.h"
+#include "scheduler/strategies/strategyRegistry.h"
+
+bool ExperimentRunner::CheckMethods(const SimulationParameters& _parameters, const std::vector<std::string>& _methods)
+{
+	bool known = true;
+	bool weighted = true;
+	for (const std::string& method : _methods)
+	{
+		const StrategyInfo* info = StrategyRegistry::Find(method);
+		if (info == nullptr)
+		{
+			std::cerr << "Unknown method: " << method << "\n";
+			known = false;
+		}
+		else if (_parameters.ImportanceShift != 0.0 && info->m_historyFrames == HISTORY_ALL)
+		{
+			std::cerr << "Error: " << method << " reads the schedules of all the previous frames: its frames cannot be weighted by _ImportanceShift\n";
+			weighted = false;
+		}
+	}
+	if (!known)
+	{
+		std::cerr << "Known methods:\n";
+		for (const std::string& name : StrategyRegistry::GetNames())
+		{
+			std::cerr << "  " << name << ": " << StrategyRegistry::Find(name)->m_description << "\n";
+		}
+	}
+	return known && weighted;
+}
+
+void ExperimentRunner::Run(SimulationParameters& _parameters, const std::vector<int>& _nbWorkers, const std::vector<std::string>& _methods, int _nbJobs)
+{
+	if (_parameters.RacingSeeds > 0 || _parameters.AdaptiveFrameWidth > 0.0)
+	{
+		RunRounds(_parameters, _nbWorkers, _methods, _nbJobs);
+		return;
+	}
+	std::vector<ExperimentJob> jobs = BuildJobs(_parameters, _nbWorkers, _methods);
+	CreateResultFolders(_parameters, jobs);
+	std::vector<FrameMetrics> metrics = RunJobs(_parameters, jobs, _nbJobs);
+	MetricsSummary summary;
+	for (size_t i = 0; i < jobs.size(); i++)
+	{
+		summary.Add(jobs[i].m_iNbWorkers, jobs[i].m_method, jobs[i].m_seed, metrics[i]);
+	}
+	summary.Write("Result");
+}
+
+std::vector<FrameMetrics> ExperimentRunner::RunJobs(const SimulationParameters& _parameters, const std::vector<ExperimentJob>& jobs, int _nbJobs)
+{
+	std::vector<FrameMetrics> metrics(jobs.size());
+	int nbThreads = std::max(1, std::min(_nbJobs, (int)jobs.size()));
+	// The hardware threads left by the jobs draw the execution times; a serial run uses none
+	int nbGenerationThreads = (_nbJobs <= 1) ? 1 : std::max(1, (int)std::thread::hardware_concurrency() / nbThreads);
+	// The times do not depend on the workers: all the jobs of a seed simulate the same times
+	std::map<int, SharedTimes> sharedTimes;
+	for (const ExperimentJob& job : jobs)
+	{
+		sharedTimes[job.m_seed].m_nbJobsLeft++;
+	}
+
+	std::atomic<size_t> nextJob(0);
+	std::mutex outputMutex;
+	auto worker = [&]()
+	{
+		for (size_t i = nextJob++; i < jobs.size(); i = nextJob++)
+		{
+			{
+				std::lock_guard<std::mutex> lock(outputMutex);
+				std::cout << " - Running scheduling algorithm " << jobs[i].m_method << " with " << jobs[i].m_iNbWorkers << " worker threads and RNG seed " << jobs[i].m_seed << "\n";
+			}
+			metrics[i] = RunJob(_parameters, jobs[i], nbGenerationThreads, sharedTimes.at(jobs[i].m_seed));
+		}
+	};
+
+	std::cout << "Running " << jobs.size() << " simulations on " << nbThreads << " thread(s)\n";
+	if (nbThreads == 1)
+	{
+		worker();
+		return metrics;
+	}
+	std::vector<std::thread> threads;
+	for (int i = 0; i < nbThreads; i++)
+	{
+		threads.push_back(std::thread(worker));
+	}
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	return metrics;
+}
+
+std::vector<ExperimentJob> ExperimentRunner::BuildJobs(const SimulationParameters& _parameters, const std::vector<int>& _nbWorkers, const std::vector<std::string>& _methods)
+{
+	std::vector<ExperimentJob> jobs;
+	std::set<std::pair<int, int>> totalExecution;
+	std::set<std::tuple<int, int, std::string>> done;
+	// Seed after seed: the times of a seed are released once its jobs are done
+	for (int seed = _parameters.m_startSeed; seed < _parameters.m_endSeed; ++seed)
+	{
+		for (int workers : _nbWorkers)
+		{
+			for (const std::string& method : _methods)
+			{
+				// Infinity approximates the critical path with 1000 workers, whatever the listed worker count
+				int fixedWorkers = StrategyRegistry::Find(method)->m_fixedWorkers;
+				int effectiveWorkers = (fixedWorkers > 0) ? fixedWorkers : workers;
+				if (!done.insert(std::make_tuple(effectiveWorkers, seed, method)).second)
+				{
+					continue;
+				}
+				bool writeTotal = totalExecution.insert(std::make_pair(seed, effectiveWorkers)).second;
+				jobs.push_back({ effectiveWorkers, seed, method, writeTotal });
+			}
+		}
+	}
+	return jobs;
+}
+
+void ExperimentRunner::CreateResultFolders(const SimulationParameters& _parameters, const std::vector<ExperimentJob>& _jobs)
+{
+	// Create folders to save results: Result/Strategy/nbWorkers/nbFrame/TXT/ and Result/Strategy/nbWorkers/nbFrame/Json/
+	std::set<std::string> folders;
+	folders.insert("Result/TotalExecution/");
+	for (const ExperimentJob& job : _jobs)
+	{
+		std::string folder = "Result/" + job.m_method + "/" + std::to_string(job.m_iNbWorkers) + "/" + std::to_string(_parameters.m_iNbFrames);
+		folders.insert(folder + "/TXT");
+		folders.insert(folder + "/Json");
+		if (_parameters.SteadyStateOutput)
+		{
+			folders.insert(folder + "/Steady");
+		}
+	}
+	for (const std::string& folder : folders)
+	{
+		if (system(("mkdir -p " + folder).c_str()) != 0)
+		{
+			std::cerr << "Warning: cannot create the folder " << folder << "\n";
+		}
+	}
+}
+
+FrameMetrics ExperimentRunner::RunJob(const SimulationParameters& _parameters, const ExperimentJob& _job, int _nbGenerationThreads, SharedTimes& _times)
+{
+	// The tasks are shared by all the jobs: the state of each simulation is kept by Simulation::Play
+	SimulationParameters parameters(_parameters);
+	parameters.m_iNbWorkers = _job.m_iNbWorkers;
+	parameters.m_seed = _job.m_seed;
+
+	if (parameters.StreamFrames == 0)
+	{
+		std::lock_guard<std::mutex> lock(_times.m_mutex);
+		if (!_times.m_store)
+		{
+			SampleCache::GetTimes(parameters, _nbGenerationThreads);
+			_times.m_store = std::make_shared<const SampleStore>(std::move(parameters.m_times));
+		}
+		parameters.m_times.Share(_times.m_store);
+	}
+	if (_job.m_totalExecution)
+	{
+		Simulation::DumpTotalExecution(parameters, _nbGenerationThreads);
+	}
+	// The Json trace needs the workers: it is only written by the simulation
+	FrameMetrics metrics;
+	if (StrategyRegistry::Find(_job.m_method)->m_criticalPath && !parameters.JsonOutput)
+	{
+		metrics = CriticalPathEngine::Play(parameters, _job.m_method, _nbGenerationThreads);
+	}
+	else
+	{
+		metrics = Simulation::Play(parameters, _job.m_method, _nbGenerationThreads);
+	}
+	std::lock_guard<std::mutex> lock(_times.m_mutex);
+	if (--_times.m_nbJobsLeft == 0)
+	{
+		_times.m_store.reset();
+	}
+	return metrics;
+}
+
+namespace
+{
+	// Metrics compared by the races: SF, DF and CS of the article
+	const int NB_RACE_METRICS = 3;
+	const char* RACE_METRIC_NAMES[NB_RACE_METRICS] = { "SF", "DF", "CS" };
+	const char* RACE_METRIC_UNITS[NB_RACE_METRICS] = { "us", "frames", "us" };
+
+	double RaceMetric(const FrameMetrics& _metrics, int _metric)
+	{
+		switch (_metric)
+		{
+		case 0: return _metrics.GetSlowestFrame();
+		case 1: return _metrics.m_delayedFrames;
+		default: return _metrics.m_cumulativeSlowdown;
+		}
+	}
+
+	// Values of a metric on the first _nbSeeds seeds of an entry
+	std::vector<double> RaceMetricValues(const RoundEntry& _entry, int _metric, size_t _nbSeeds)
+	{
+		std::vector<double> values;
+		for (size_t i = 0; i < _nbSeeds; i++)
+		{
+			values.push_back(RaceMetric(_entry.m_metrics[i], _metric));
+		}
+		return values;
+	}
+
+	double MeanRaceMetric(const RoundEntry& _entry, int _metric, size_t _nbSeeds)
+	{
+		return Statistics::Mean(RaceMetricValues(_entry, _metric, _nbSeeds));
+	}
+
+	// SF is not available under importance sampling
+	bool IsRaceMetricAvailable(const SimulationParameters& _parameters, int _metric)
+	{
+		return _metric != 0 || _parameters.ImportanceShift == 0.0;
+	}
+
+	// Seeds drawn together: an antithetic pair or a Latin hypercube
+	int GetBlockSeeds(const SimulationParameters& _parameters)
+	{
+		switch (_parameters.Sampling)
+		{
+		case SamplingMode::ANTITHETIC: return 2;
+		case SamplingMode::LATIN_HYPERCUBE: return LATIN_HYPERCUBE_SEEDS;
+		default: return 1;
+		}
+	}
+
+	// Seeds of a round: the seeds of a block are run in the same round
+	int GetRoundSeeds(const SimulationParameters& _parameters)
+	{
+		int roundSeeds = (_parameters.RacingSeeds > 0) ? _parameters.RacingSeeds : 1;
+		int blockSeeds = GetBlockSeeds(_parameters);
+		return (roundSeeds + blockSeeds - 1) / blockSeeds * blockSeeds;
+	}
+
+	// The seeds of an antithetic pair or of a Latin hypercube are not independent, while the
+	// blocks are: the statistics are computed on the means of the blocks, an incomplete block left out
+	std::vector<double> IndependentSamples(const SimulationParameters& _parameters, const std::vector<double>& _values)
+	{
+		size_t blockSeeds = GetBlockSeeds(_parameters);
+		if (blockSeeds == 1)
+		{
+			return _values;
+		}
+		std::vector<double> samples;
+		for (size_t i = 0; i + blockSeeds <= _values.size(); i += blockSeeds)
+		{
+			double sum = 0.0;
+			for (size_t j = i; j < i + blockSeeds; j++)
+			{
+				sum += _values[j];
+			}
+			samples.push_back(sum / blockSeeds);
+		}
+		return samples;
+	}
+}
+
+void ExperimentRunner::RunRounds(SimulationParameters& _parameters, const std::vector<int>& _nbWorkers, const std::vector<std::string>& _methods, int _nbJobs)
+{
+	CreateResultFolders(_parameters, BuildJobs(_parameters, _nbWorkers, _methods));
+
+	// One entry per (effective workers, method), as in BuildJobs
+	std::vector<RoundEntry> entries;
+	std::set<std::pair<int, std::string>> done;
+	for (int workers : _nbWorkers)
+	{
+		for (const std::string& method : _methods)
+		{
+			int fixedWorkers = StrategyRegistry::Find(method)->m_fixedWorkers;
+			int effectiveWorkers = (fixedWorkers > 0) ? fixedWorkers : workers;
+			if (done.insert(std::make_pair(effectiveWorkers, method)).second)
+			{
+				entries.push_back({ effectiveWorkers, method, {}, false, false, "" });
+			}
+		}
+	}
+
+	MetricsSummary summary;
+	std::set<std::pair<int, int>> totalExecution;
+	int roundSeeds = GetRoundSeeds(_parameters);
+	for (int firstSeed = _parameters.m_startSeed; firstSeed < _parameters.m_endSeed; firstSeed += roundSeeds)
+	{
+		int endSeed = std::min(firstSeed + roundSeeds, _parameters.m_endSeed);
+		std::vector<ExperimentJob> jobs;
+		std::vector<RoundEntry*> owners;
+		// Seed after seed: each entry gets its metrics in seed order
+		for (int seed = firstSeed; seed < endSeed; seed++)
+		{
+			for (RoundEntry& entry : entries)
+			{
+				if (!entry.m_pruned && !entry.m_converged)
+				{
+					bool writeTotal = totalExecution.insert(std::make_pair(seed, entry.m_iNbWorkers)).second;
+					jobs.push_back({ entry.m_iNbWorkers, seed, entry.m_method, writeTotal });
+					owners.push_back(&entry);
+				}
+			}
+		}
+		if (jobs.empty())
+		{
+			break;
+		}
+		std::cout << "Round on RNG seeds [" << firstSeed << "," << endSeed << "[\n";
+		std::vector<FrameMetrics> metrics = RunJobs(_parameters, jobs, _nbJobs);
+		for (size_t i = 0; i < jobs.size(); i++)
+		{
+			owners[i]->m_metrics.push_back(metrics[i]);
+			summary.Add(jobs[i].m_iNbWorkers, jobs[i].m_method, jobs[i].m_seed, metrics[i]);
+		}
+
+		if (_parameters.AdaptiveFrameWidth > 0.0)
+		{
+			// The entries that ran this round, once each
+			for (RoundEntry& entry : entries)
+			{
+				if (!entry.m_pruned && !entry.m_converged)
+				{
+					CheckConvergence(_parameters, entry);
+				}
+			}
+		}
+		if (_parameters.RacingSeeds == 0)
+		{
+			continue;
+		}
+		// The methods only race against the methods with the same number of workers
+		std::set<int> workerCounts;
+		for (const RoundEntry& entry : entries)
+		{
+			workerCounts.insert(entry.m_iNbWorkers);
+		}
+		for (int workers : workerCounts)
+		{
+			std::vector<RoundEntry*> group;
+			for (RoundEntry& entry : entries)
+			{
+				if (entry.m_iNbWorkers == workers && !entry.m_pruned)
+				{
+					group.push_back(&entry);
+				}
+			}
+			PruneRace(_parameters, group);
+		}
+	}
+	WriteRoundReport(entries);
+	summary.Write("Result");
+}
+
+// The best method has the lowest mean CS, then DF, then SF, on the seeds run by all the methods
+// (SF is left out under importance sampling).
+// Each other method gets a two-sided paired t-test against it on every metric: all the methods of a
+// worker count are run on the same seeds, so their frames share their times. A method is dropped
+// when it is found worse on a metric and better on none.
+// The race tests every method on every metric after every round: the error rate of 5% is split
+// evenly over the rounds (Bonferroni), and over the tests of a round with the step-down of Holm,
+// so that a method as good as the best one is dropped in less than 5% of the races. The rounds are
+// counted over the whole seed range, even when converged or pruned methods end the race sooner:
+// the split is deliberately conservative.
+void ExperimentRunner::PruneRace(const SimulationParameters& _parameters, std::vector<RoundEntry*>& _entries)
+{
+	static const double RACE_ERROR_RATE = 0.05;
+
+	if (_entries.size() < 2)
+	{
+		return;
+	}
+	// A configuration that converged stops at its seeds: the best method is chosen on the seeds of all,
+	// so that the choice does not depend on the order of the methods
+	size_t nbCommonSeeds = _entries[0]->m_metrics.size();
+	for (RoundEntry* entry : _entries)
+	{
+		nbCommonSeeds = std::min(nbCommonSeeds, entry->m_metrics.size());
+	}
+	RoundEntry* best = _entries[0];
+	for (RoundEntry* entry : _entries)
+	{
+		for (int metric = NB_RACE_METRICS - 1; metric >= 0 && IsRaceMetricAvailable(_parameters, metric); metric--)
+		{
+			double mean = MeanRaceMetric(*entry, metric, nbCommonSeeds);
+			double bestMean = MeanRaceMetric(*best, metric, nbCommonSeeds);
+			if (mean != bestMean)
+			{
+				if (mean < bestMean)
+				{
+					best = entry;
+				}
+				break;
+			}
+		}
+	}
+
+	// One test per method and metric, with its p-value; the comparisons with the best method go on
+	// with all the seeds the two of them ran
+	struct Test
+	{
+		RoundEntry* m_entry;
+		int m_metric;
+		size_t m_nbSeeds;
+		double m_mean;
+		double m_pValue;
+	};
+	std::vector<Test> tests;
+	for (RoundEntry* entry : _entries)
+	{
+		size_t nbSeeds = std::min(entry->m_metrics.size(), best->m_metrics.size());
+		size_t nbSamples = IndependentSamples(_parameters, std::vector<double>(nbSeeds)).size();
+		if (entry == best || nbSamples < 2)
+		{
+			continue;
+		}
+		for (int metric = 0; metric < NB_RACE_METRICS; metric++)
+		{
+			if (!IsRaceMetricAvailable(_parameters, metric))
+			{
+				continue;
+			}
+			std::vector<double> differences;
+			for (size_t i = 0; i < nbSeeds; i++)
+			{
+				differences.push_back(RaceMetric(entry->m_metrics[i], metric) - RaceMetric(best->m_metrics[i], metric));
+			}
+			differences = IndependentSamples(_parameters, differences);
+			double mean = Statistics::Mean(differences);
+			double error = std::sqrt(Statistics::Variance(differences) / nbSamples);
+			double pValue = (error > 0.0) ? 2.0 * Statistics::StudentUpperTail(std::fabs(mean) / error, nbSamples - 1) : (mean == 0.0) ? 1.0 : 0.0;
+			tests.push_back({ entry, metric, nbSeeds, mean, pValue });
+		}
+	}
+
+	// Holm: the k-th smallest p-value of the m tests is compared to the rate of the round over m - k,
+	// as long as the smaller ones passed; the first metric found worse gives the reason
+	int roundSeeds = GetRoundSeeds(_parameters);
+	int nbRounds = (_parameters.m_endSeed - _parameters.m_startSeed + roundSeeds - 1) / roundSeeds;
+	double roundRate = RACE_ERROR_RATE / std::max(1, nbRounds);
+	std::stable_sort(tests.begin(), tests.end(), [](const Test& _a, const Test& _b) { return _a.m_pValue < _b.m_pValue; });
+	std::map<RoundEntry*, const Test*> firstWorse;
+	std::set<RoundEntry*> better;
+	for (size_t k = 0; k < tests.size() && tests[k].m_pValue <= roundRate / (tests.size() - k); k++)
+	{
+		if (tests[k].m_mean < 0.0)
+		{
+			better.insert(tests[k].m_entry);
+			continue;
+		}
+		const Test*& first = firstWorse[tests[k].m_entry];
+		if (first == nullptr || tests[k].m_metric < first->m_metric)
+		{
+			first = &tests[k];
+		}
+	}
+	for (const auto& entry : firstWorse)
+	{
+		if (better.count(entry.first) > 0)
+		{
+			continue;
+		}
+		const Test& test = *entry.second;
+		std::ostringstream text;
+		text << RACE_METRIC_NAMES[test.m_metric] << " +" << test.m_mean << " " << RACE_METRIC_UNITS[test.m_metric] << " over " << best->m_method
+			<< " after " << test.m_nbSeeds << " seeds (p " << test.m_pValue << ")";
+		entry.first->m_pruned = true;
+		entry.first->m_reason = text.str();
+	}
+}
+
+// Two-sided 95% intervals on the mean over the seeds of the mean frame duration and of DF.
+// At least ADAPTIVE_MIN_SEEDS seeds are run, so that a few close first seeds do not stop it.
+void ExperimentRunner::CheckConvergence(const SimulationParameters& _parameters, RoundEntry& _entry)
+{
+	static const size_t ADAPTIVE_MIN_SEEDS = 5;
+	size_t nbSeeds = _entry.m_metrics.size();
+	if (nbSeeds < 2)
+	{
+		return;
+	}
+	std::vector<double> frames;
+	std::vector<double> delayed;
+	for (const FrameMetrics& metrics : _entry.m_metrics)
+	{
+		frames.push_back(metrics.GetMeanFrame());
+		delayed.push_back(metrics.m_delayedFrames);
+	}
+	frames = IndependentSamples(_parameters, frames);
+	delayed = IndependentSamples(_parameters, delayed);
+	size_t nbSamples = frames.size();
+	if (nbSamples < 2)
+	{
+		return;
+	}
+	double quantile = Statistics::StudentQuantile(0.975, nbSamples - 1);
+	double frameWidth = 2.0 * quantile * std::sqrt(Statistics::Variance(frames) / nbSamples);
+	double delayedWidth = 2.0 * quantile * std::sqrt(Statistics::Variance(delayed) / nbSamples);
+
+	std::ostringstream text;
+	text << "mean frame " << Statistics::Mean(frames) << " +/- " << frameWidth / 2.0 << " us, DF " << Statistics::Mean(delayed) << " +/- " << delayedWidth / 2.0 << " frames after " << nbSeeds << " seeds";
+	_entry.m_reason = text.str();
+	_entry.m_converged = nbSeeds >= ADAPTIVE_MIN_SEEDS && frameWidth <= _parameters.AdaptiveFrameWidth && delayedWidth <= _parameters.AdaptiveDelayedWidth;
+}
+
+void ExperimentRunner::WriteRoundReport(const std::vector<RoundEntry>& _entries)
+{
+	// One line per method: workers, method, seeds run, mean SF, DF and CS, and its outcome
+	std::ofstream report("Result/Rounds.txt");
+	std::cout << "Results of the rounds:\n";
+	for (const RoundEntry& entry : _entries)
+	{
+		std::ostringstream line;
+		line << entry.m_iNbWorkers << " " << entry.m_method << " " << entry.m_metrics.size();
+		for (int metric = 0; metric < NB_RACE_METRICS; metric++)
+		{
+			double mean = MeanRaceMetric(entry, metric, entry.m_metrics.size());
+			if (std::isnan(mean))
+			{
+				line << " -";
+			}
+			else
+			{
+				line << " " << mean;
+			}
+		}
+		if (entry.m_pruned)
+		{
+			line << " pruned: " << entry.m_reason;
+		}
+		else if (entry.m_converged)
+		{
+			line << " converged: " << entry.m_reason;
+		}
+		else
+		{
+			line << " kept" << (entry.m_reason.empty() ? "" : ": " + entry.m_reason);
+		}
+		report << line.str() << "\n";
+		std::cout << " - " << line.str() << "\n";
+	}
+}
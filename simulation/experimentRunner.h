@@ -0,0 +1,67 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "simulation.h"
+
+// One simulation to run: number of workers, RNG seed and scheduling method
+struct ExperimentJob
+{
+	int m_iNbWorkers;
+	int m_seed;
+	std::string m_method;
+	bool m_totalExecution; // the job writes the TotalExecution file of its (seed, workers)
+};
+
+// A (workers, method) configuration run seed after seed: its metrics on the seeds it was run on,
+// and why no more seeds are run for it
+struct RoundEntry
+{
+	int m_iNbWorkers;
+	std::string m_method;
+	std::vector<FrameMetrics> m_metrics; // by seed, from the first seed
+	bool m_pruned; // dropped by the race
+	bool m_converged; // confidence intervals narrow enough
+	std::string m_reason;
+};
+
+class ExperimentRunner
+{
+public:
+	// Report the unknown methods, and the methods whose frames importance sampling cannot weight:
+	// nothing should run when one of them is selected
+	static bool CheckMethods(const SimulationParameters& _parameters, const std::vector<std::string>& _methods);
+	// Run every (workers, seed, method) configuration, using up to _nbJobs threads, and write
+	// the summary tables of their metrics to Result/Summary.txt and Result/SummarySeeds.txt
+	static void Run(SimulationParameters& _parameters, const std::vector<int>& _nbWorkers, const std::vector<std::string>& _methods, int _nbJobs);
+	static std::vector<ExperimentJob> BuildJobs(const SimulationParameters& _parameters, const std::vector<int>& _nbWorkers, const std::vector<std::string>& _methods);
+	static void CreateResultFolders(const SimulationParameters& _parameters, const std::vector<ExperimentJob>& _jobs);
+	// Run the configurations in rounds of seeds, _parameters.RacingSeeds at a time or one by one.
+	// After each round, a configuration is not run on the next seeds when the race finds its method
+	// statistically worse than the best one of its worker count, or when the confidence intervals
+	// of its metrics are narrower than _parameters.AdaptiveFrameWidth and AdaptiveDelayedWidth.
+	// The outcome of each configuration is written to Result/Rounds.txt
+	static void RunRounds(SimulationParameters& _parameters, const std::vector<int>& _nbWorkers, const std::vector<std::string>& _methods, int _nbJobs);
+
+private:
+	// Times of the jobs of a seed, for all the worker counts: drawn by the first job of the group to run,
+	// shared by the others, and released after the last one
+	struct SharedTimes
+	{
+		std::mutex m_mutex;
+		std::shared_ptr<const SampleStore> m_store;
+		int m_nbJobsLeft = 0;
+	};
+
+	// Run the jobs on up to _nbJobs threads: the metrics of the jobs are returned in the same order
+	static std::vector<FrameMetrics> RunJobs(const SimulationParameters& _parameters, const std::vector<ExperimentJob>& _jobs, int _nbJobs);
+	// _nbGenerationThreads: threads drawing the execution times of the job
+	static FrameMetrics RunJob(const SimulationParameters& _parameters, const ExperimentJob& _job, int _nbGenerationThreads, SharedTimes& _times);
+	// Drop the methods of _entries, with the same worker count, dominated by the best one
+	static void PruneRace(const SimulationParameters& _parameters, std::vector<RoundEntry*>& _entries);
+	// Stop running _entry once the 95% confidence intervals of its metrics are narrow enough
+	static void CheckConvergence(const SimulationParameters& _parameters, RoundEntry& _entry);
+	static void WriteRoundReport(const std::vector<RoundEntry>& _entries);
+};
@@ -0,0 +1,81 @@
+#include <stdafx.h>
+#include <algorithm>
+
+#include "frameBounds.h"
+
+// The tasks are visited once per frame, each one after its fathers
+FrameBounds::FrameBounds(const TaskSequence& _sequence, int _nbWorkers)
+{
+	m_nbWorkers = _nbWorkers;
+	m_criticalPath = 0.0;
+	m_work = 0.0;
+	m_graphicWork = 0.0;
+
+	const std::vector<Task*>& tasks = _sequence.GetTasks();
+	std::vector<int> remainingFathers(tasks.size());
+	for (Task* task : tasks)
+	{
+		remainingFathers[task->GetIndex()] = task->GetFathers().size();
+		if (task->GetFathers().empty())
+		{
+			m_fathersFirst.push_back(task);
+		}
+	}
+	for (size_t i = 0; i < m_fathersFirst.size(); i++)
+	{
+		for (Task* son : m_fathersFirst[i]->GetSons())
+		{
+			if (--remainingFathers[son->GetIndex()] == 0)
+			{
+				m_fathersFirst.push_back(son);
+			}
+		}
+	}
+	m_pathEnd.resize(tasks.size());
+}
+
+void FrameBounds::Compute(SequenceState& _state)
+{
+	double totalWork = 0.0;
+	m_criticalPath = 0.0;
+	m_graphicWork = 0.0;
+	for (const Task* task : m_fathersFirst)
+	{
+		TaskState* state = _state.GetState(task);
+		double start = 0.0;
+		for (Task* father : task->GetFathers())
+		{
+			start = std::max(start, m_pathEnd[father->GetIndex()]);
+		}
+		double duration;
+		if (task->GetTaskType() == TaskType::GRAPHIC)
+		{
+			duration = state->GetStartTotalTime();
+			m_graphicWork += duration;
+		}
+		else
+		{
+			duration = state->GetStartLongestTime();
+		}
+		m_pathEnd[task->GetIndex()] = start + duration;
+		m_criticalPath = std::max(m_criticalPath, start + duration);
+		totalWork += state->GetStartTotalTime();
+	}
+	m_work = totalWork / m_nbWorkers;
+}
+
+double FrameBounds::GetBest() const
+{
+	return std::max(m_criticalPath, std::max(m_work, m_graphicWork));
+}
+
+double FrameBounds::GetRatio(double _duration) const
+{
+	double best = GetBest();
+	return (best > 0.0) ? _duration / best : 1.0;
+}
+
+void FrameBounds::Write(std::ostream& _file, double _duration) const
+{
+	_file << " " << m_criticalPath << " " << m_work << " " << m_graphicWork << " " << GetRatio(_duration);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <ostream>
+#include <vector>
+#include "tasks/taskSequence.h"
+#include "tasks/sequenceState.h"
+
+// Lower bounds of the duration of a frame, from the times of its tasks when the frame starts:
+// - the critical path, an engine task lasting its longest step and a graphic task all its steps,
+// - the work of all the tasks shared by all the workers,
+// - the work of the graphic tasks, all run by worker 0.
+// No schedule of the frame on _nbWorkers workers ends before the largest of the three.
+class FrameBounds
+{
+public:
+	FrameBounds(const TaskSequence& _sequence, int _nbWorkers);
+
+	//BOUNDS OF THE FRAME PLAYED WITH _state: THE TASKS MUST BE INITIALIZED FOR THE FRAME
+	void Compute(SequenceState& _state);
+
+	double GetCriticalPath() const { return m_criticalPath; };
+	double GetWork() const { return m_work; };
+	double GetGraphicWork() const { return m_graphicWork; };
+	double GetBest() const;
+	//DURATION OF THE FRAME OVER ITS BEST BOUND: 1 FOR AN OPTIMAL SCHEDULE
+	double GetRatio(double _duration) const;
+
+	//COLUMNS ADDED TO THE LINE OF THE FRAME: CRITICAL PATH, WORK PER WORKER, GRAPHIC WORK, RATIO
+	void Write(std::ostream& _file, double _duration) const;
+
+private:
+	int m_nbWorkers;
+	std::vector<const Task*> m_fathersFirst;
+	std::vector<double> m_pathEnd; // longest path to the end of each task
+	double m_criticalPath;
+	double m_work;
+	double m_graphicWork;
+};
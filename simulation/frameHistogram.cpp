@@ -0,0 +1,73 @@
+#include <stdafx.h>
+#include <algorithm>
+
+#include "frameHistogram.h"
+
+namespace
+{
+	const int SUB_BUCKETS = 1 << FrameHistogram::SUB_BUCKET_BITS;
+	const int HALF_SUB_BUCKETS = SUB_BUCKETS / 2;
+	// Durations from 2^30 us (about 18 minutes) count in the last bucket
+	const uint64_t MAX_VALUE = (1ull << 30) - 1;
+}
+
+// Value v = sub * 2^e with sub in [SUB_BUCKETS/2, SUB_BUCKETS[, or e = 0 and v < SUB_BUCKETS
+int FrameHistogram::Bucket(uint64_t _value)
+{
+	int exponent = 0;
+	while ((_value >> exponent) >= (uint64_t)SUB_BUCKETS)
+	{
+		exponent++;
+	}
+	return exponent * HALF_SUB_BUCKETS + (int)(_value >> exponent);
+}
+
+double FrameHistogram::BucketMiddle(int _bucket)
+{
+	int exponent = (_bucket < SUB_BUCKETS) ? 0 : _bucket / HALF_SUB_BUCKETS - 1;
+	uint64_t low = (uint64_t)(_bucket - exponent * HALF_SUB_BUCKETS) << exponent;
+	return low + ((1ull << exponent) - 1) / 2.0;
+}
+
+void FrameHistogram::Add(double _duration, double _weight)
+{
+	if (m_counts.empty())
+	{
+		m_counts.resize(Bucket(MAX_VALUE) + 1, 0.0);
+	}
+	uint64_t value = (uint64_t)std::min(std::max(_duration + 0.5, 0.0), (double)MAX_VALUE);
+	m_counts[Bucket(value)] += _weight;
+	m_count += _weight;
+}
+
+void FrameHistogram::Merge(const FrameHistogram& _histogram)
+{
+	if (_histogram.m_counts.empty())
+	{
+		return;
+	}
+	if (m_counts.empty())
+	{
+		m_counts.resize(_histogram.m_counts.size(), 0.0);
+	}
+	for (size_t i = 0; i < m_counts.size(); i++)
+	{
+		m_counts[i] += _histogram.m_counts[i];
+	}
+	m_count += _histogram.m_count;
+}
+
+double FrameHistogram::GetQuantile(double _p) const
+{
+	double target = _p * m_count;
+	double count = 0.0;
+	for (size_t i = 0; i < m_counts.size(); i++)
+	{
+		count += m_counts[i];
+		if (m_counts[i] > 0.0 && count >= target)
+		{
+			return BucketMiddle(i);
+		}
+	}
+	return 0.0;
+}
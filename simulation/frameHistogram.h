@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Histogram of frame durations in the HdrHistogram layout: values below 2^SUB_BUCKET_BITS
+// microseconds have one bucket each, and each following power of two is split into
+// 2^(SUB_BUCKET_BITS-1) buckets, so that a quantile is known within 1/128 of its value.
+// Adding a frame and merging histograms only add counts: the buckets are allocated on the first frame.
+class FrameHistogram
+{
+public:
+	static const int SUB_BUCKET_BITS = 8;
+
+	//ADD A DURATION IN MICROSECONDS, COUNTING FOR _weight FRAMES
+	void Add(double _duration, double _weight = 1.0);
+	//ADD THE FRAMES OF ANOTHER HISTOGRAM
+	void Merge(const FrameHistogram& _histogram);
+
+	double GetCount() const { return m_count; };
+	//DURATION BELOW WHICH A PROPORTION _p OF THE FRAMES ARE, THE MIDDLE OF ITS BUCKET; 0 WITHOUT ANY FRAME
+	double GetQuantile(double _p) const;
+
+private:
+	static int Bucket(uint64_t _value);
+	static double BucketMiddle(int _bucket);
+
+	std::vector<double> m_counts;
+	double m_count = 0.0;
+};
@@ -0,0 +1,31 @@
+#include <stdafx.h>
+
+#include "frameMetrics.h"
+
+const double FrameMetrics::DUE_DATE = 16667.0;
+
+void FrameMetrics::Add(double _duration, double _weight)
+{
+	m_nbFrames++;
+	m_totalDuration += _weight * _duration;
+	m_slowestFrame = std::max(m_slowestFrame, _duration);
+	m_durations.Add(_duration, _weight);
+	if (_duration > DUE_DATE)
+	{
+		m_delayedFrames += _weight;
+		m_cumulativeSlowdown += _weight * (_duration - DUE_DATE);
+	}
+}
+
+void FrameMetrics::AddEstimate(int _nbFrames, const FrameMetrics& _sample)
+{
+	if (_sample.m_nbFrames == 0)
+	{
+		return;
+	}
+	double scale = (double)_nbFrames / _sample.m_nbFrames;
+	m_nbFrames += _nbFrames;
+	m_totalDuration += scale * _sample.m_totalDuration;
+	m_delayedFrames += scale * _sample.m_delayedFrames;
+	m_cumulativeSlowdown += scale * _sample.m_cumulativeSlowdown;
+}
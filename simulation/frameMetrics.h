@@ -0,0 +1,31 @@
+#pragma once
+
+#include <limits>
+#include "frameHistogram.h"
+
+// Metrics of the article on the frames of one simulation, against the due date of a 60 FPS frame:
+// slowest frame (SF), number of delayed frames (DF) and cumulative slowdown of the delayed frames (CS).
+// Under importance sampling, each frame counts for its likelihood ratio in DF, CS and the mean
+// frame and its quantiles, so that they estimate the values without it. SF is then not available:
+// the slowest frame simulated does not estimate the slowest frame without it.
+struct FrameMetrics
+{
+	//DUE DATE OF A FRAME, IN MICROSECONDS, AS IN THE ANALYSIS SCRIPTS
+	static const double DUE_DATE;
+
+	bool m_weighted = false; // frames drawn under importance sampling
+	int m_nbFrames = 0;
+	double m_slowestFrame = 0.0;
+	double m_delayedFrames = 0.0;
+	double m_cumulativeSlowdown = 0.0;
+	double m_totalDuration = 0.0;
+	FrameHistogram m_durations; // frames played, for the quantiles
+
+	//ADD THE DURATION OF THE NEXT FRAME
+	void Add(double _duration, double _weight = 1.0);
+	//ADD _nbFrames FRAMES NOT PLAYED, AT THE RATES OF THE FRAMES OF _sample (SF IS LEFT AS IT IS)
+	void AddEstimate(int _nbFrames, const FrameMetrics& _sample);
+	//SF, NaN UNDER IMPORTANCE SAMPLING
+	double GetSlowestFrame() const { return m_weighted ? std::numeric_limits<double>::quiet_NaN() : m_slowestFrame; };
+	double GetMeanFrame() const { return (m_nbFrames > 0) ? m_totalDuration / m_nbFrames : 0.0; };
+};
@@ -0,0 +1,109 @@
+#include <stdafx.h>
+
+#include "frameStream.h"
+#include "simulationUtils.h"
+
+FrameStream::FrameStream(const SimulationParameters& _parameters, int _nbThreads)
+	: m_parameters(_parameters), m_lagGenerator(true)
+{
+	m_nbThreads = _nbThreads;
+	m_streaming = _parameters.StreamFrames > 0;
+	m_nextFrame = 0;
+	if (m_streaming)
+	{
+		// The frame before the one played is kept
+		m_ring.resize(std::max(2, _parameters.StreamFrames));
+		m_taskOrder = _parameters.m_sequence.GetIndicesByName();
+	}
+}
+
+void FrameStream::Load(int _frame)
+{
+	if (!m_streaming || _frame < m_nextFrame)
+	{
+		return;
+	}
+	// Draw the next frames in the slots free after _frame - 1: the buffers keep their capacity
+	const std::vector<Task*>& tasks = m_parameters.m_sequence.GetTasks();
+	int firstFrame = m_nextFrame;
+	int nbFrames = std::min((int)m_ring.size() - 1, m_parameters.m_iNbFrames - firstFrame);
+	for (int i = firstFrame; i < firstFrame + nbFrames; i++)
+	{
+		Frame& frame = m_ring[i % m_ring.size()];
+		frame.m_lag = m_lagGenerator.Next();
+		frame.m_offsets.resize(tasks.size() + 1);
+		frame.m_offsets[0] = 0;
+		for (Task* task : tasks)
+		{
+			frame.m_offsets[task->GetIndex() + 1] = frame.m_offsets[task->GetIndex()] + SimulationUtils::GetSampleCount(m_parameters, task, frame.m_lag);
+		}
+		frame.m_times.resize(frame.m_offsets.back());
+		frame.m_totals.resize(tasks.size());
+	}
+	SimulationUtils::ForEachFrame(nbFrames, m_nbThreads, [&](int _frame)
+	{
+		int index = firstFrame + _frame;
+		Frame& frame = m_ring[index % m_ring.size()];
+		std::vector<double> shifts = SimulationUtils::GetImportanceShifts(m_parameters, frame.m_lag);
+		frame.m_logWeight = 0.0;
+		for (Task* task : tasks)
+		{
+			frame.m_logWeight += SimulationUtils::SampleTimes(m_parameters, index, frame.m_lag, task, shifts[task->GetIndex()], frame.m_times.data() + frame.m_offsets[task->GetIndex()]);
+		}
+		// Same additions as SampleStore::ComputeTotals
+		for (Task* task : tasks)
+		{
+			int taskIndex = task->GetIndex();
+			frame.m_totals[taskIndex] = SampleStore::Totals(frame.m_times.data() + frame.m_offsets[taskIndex], frame.m_offsets[taskIndex + 1] - frame.m_offsets[taskIndex]);
+		}
+		frame.m_total = 0.0;
+		for (int taskIndex : m_taskOrder)
+		{
+			for (uint64_t j = frame.m_offsets[taskIndex]; j < frame.m_offsets[taskIndex + 1]; j++)
+			{
+				frame.m_total += frame.m_times[j];
+			}
+		}
+	});
+	m_nextFrame = firstFrame + nbFrames;
+}
+
+double FrameStream::GetLag(int _frame) const
+{
+	return m_streaming ? GetFrame(_frame).m_lag : m_parameters.m_lags[_frame];
+}
+
+int FrameStream::GetCount(int _frame, int _task) const
+{
+	if (!m_streaming)
+	{
+		return m_parameters.m_times.GetCount(_frame, _task);
+	}
+	const Frame& frame = GetFrame(_frame);
+	return frame.m_offsets[_task + 1] - frame.m_offsets[_task];
+}
+
+const double* FrameStream::GetTimes(int _frame, int _task) const
+{
+	if (!m_streaming)
+	{
+		return m_parameters.m_times.GetTimes(_frame, _task);
+	}
+	const Frame& frame = GetFrame(_frame);
+	return frame.m_times.data() + frame.m_offsets[_task];
+}
+
+const TimeTotals& FrameStream::GetTotals(int _frame, int _task) const
+{
+	return m_streaming ? GetFrame(_frame).m_totals[_task] : m_parameters.m_times.GetTotals(_frame, _task);
+}
+
+double FrameStream::GetFrameTotal(int _frame) const
+{
+	return m_streaming ? GetFrame(_frame).m_total : m_parameters.m_times.GetFrameTotal(_frame);
+}
+
+double FrameStream::GetLogWeight(int _frame) const
+{
+	return m_streaming ? GetFrame(_frame).m_logWeight : m_parameters.m_times.GetLogWeight(_frame);
+}
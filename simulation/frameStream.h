@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "simulation.h"
+#include "lagGenerator.h"
+
+// Lags and execution times of the frames, as read by a simulation.
+// Without streaming, the frames are those of _parameters.m_lags and _parameters.m_times.
+// With _parameters.StreamFrames > 0, the frames are drawn while the simulation runs into a ring
+// of StreamFrames frames, refilled just ahead of the frame played, so that the memory used does
+// not depend on the number of frames. The streamed lags always use the counter-based draws:
+// the legacy std::rand sequence is shared by the whole process.
+class FrameStream
+{
+public:
+	FrameStream(const SimulationParameters& _parameters, int _nbThreads);
+
+	//MAKE FRAME _frame AND THE FRAME BEFORE IT AVAILABLE: FRAMES ARE LOADED IN INCREASING ORDER
+	void Load(int _frame);
+
+	double GetLag(int _frame) const;
+	int GetCount(int _frame, int _task) const;
+	const double* GetTimes(int _frame, int _task) const;
+	//TOTALS OF THE TIMES OF A TASK, AND SUM OF ALL THE TIMES OF A FRAME
+	const TimeTotals& GetTotals(int _frame, int _task) const;
+	double GetFrameTotal(int _frame) const;
+	//LOG OF THE LIKELIHOOD RATIO OF THE TIMES OF A FRAME UNDER IMPORTANCE SAMPLING
+	double GetLogWeight(int _frame) const;
+
+private:
+	struct Frame
+	{
+		double m_lag;
+		std::vector<uint64_t> m_offsets;
+		std::vector<double> m_times;
+		std::vector<TimeTotals> m_totals;
+		double m_total;
+		double m_logWeight;
+	};
+
+	const Frame& GetFrame(int _frame) const { return m_ring[_frame % m_ring.size()]; };
+
+	const SimulationParameters& m_parameters;
+	int m_nbThreads;
+	bool m_streaming;
+	LagGenerator m_lagGenerator;
+	int m_nextFrame; // first frame not drawn yet
+	std::vector<Frame> m_ring;
+	std::vector<int> m_taskOrder; // tasks in name order, as the frame totals are added
+};
@@ -0,0 +1,46 @@
+#include <stdafx.h>
+#include <cstdlib>
+
+#include "lagGenerator.h"
+
+// The lags are the same for all the seeds of an experiment
+LagGenerator::LagGenerator(bool _counterRng) : m_rng(0)
+{
+	m_counterRng = _counterRng;
+	m_frame = 0;
+	m_simulationLagStatus = false;
+	m_maxLagFrame = 200;
+	m_countLagFrame = 1;
+	m_lagProportion = 0;
+}
+
+double LagGenerator::Next()
+{
+	double lag;
+	if (m_simulationLagStatus == false) {
+		m_countLagFrame = 1;
+		lag = m_lagProportion;
+		if (m_counterRng)
+		{
+			m_simulationLagStatus = ((int)(m_rng.Uniform(0, 0, m_frame, CounterRng::LAG) * 2000) > 200);
+		}
+		else
+		{
+			m_simulationLagStatus = ((std::rand() % 2000) > 200);
+		}
+	}
+
+	else {
+		if (m_countLagFrame < (m_maxLagFrame / 2))
+			m_lagProportion = 2 * m_countLagFrame / m_maxLagFrame;
+
+		else
+			m_lagProportion = 2 * (1 - m_countLagFrame / m_maxLagFrame);
+
+		lag = m_lagProportion;
+		m_countLagFrame++;
+		m_simulationLagStatus = (m_countLagFrame != m_maxLagFrame);
+	}
+	m_frame++;
+	return lag;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "counterRng.h"
+
+// Lag proportion of each frame, frame after frame: a lag episode of 200 frames starts with a
+// probability of 0.9 after each frame without lag, its lag rising to 1 then falling back to 0.
+// The legacy draws use the global std::rand; the counter-based draws only depend on the frame.
+class LagGenerator
+{
+public:
+	LagGenerator(bool _counterRng);
+
+	//LAG OF THE NEXT FRAME
+	double Next();
+
+private:
+	bool m_counterRng;
+	CounterRng m_rng;
+	int m_frame;
+	bool m_simulationLagStatus;
+	double m_maxLagFrame;
+	double m_countLagFrame;
+	double m_lagProportion;
+};
@@ -0,0 +1,218 @@
+#include <stdafx.h>
+#include <cstring>
+
+#include "lognormalSampler.h"
+#include "statistics.h"
+#include "simulation.h"
+
+namespace
+{
+	const double LN2_HI = 6.93147180369123816490e-01;
+	const double LN2_LO = 1.90821492927058770002e-10;
+	const double LOG2E = 1.44269504088896338700e+00;
+	const double SQRT2 = 1.41421356237309504880e+00;
+	const double HALF_PI = 1.57079632679489661923e+00;
+	// Adding then removing it rounds a double to the nearest integer
+	const double ROUND_MAGIC = 6755399441055744.0;
+	const double TWO_52 = 4503599627370496.0;
+	const double FACTORIAL[17] = { 1.0, 1.0, 2.0, 6.0, 24.0, 120.0, 720.0, 5040.0, 40320.0, 362880.0, 3628800.0, 39916800.0,
+		479001600.0, 6227020800.0, 87178291200.0, 1307674368000.0, 20922789888000.0 };
+
+	inline uint64_t Bits(double _x)
+	{
+		uint64_t bits;
+		std::memcpy(&bits, &_x, sizeof(bits));
+		return bits;
+	}
+
+	inline double FromBits(uint64_t _bits)
+	{
+		double x;
+		std::memcpy(&x, &_bits, sizeof(x));
+		return x;
+	}
+}
+
+// A zero mean (e.g. 007 under full lag) gives undefined parameters: the time is the minimum
+inline double LognormalSampler::Clamp(double _time, const TimeDistribution& _distribution)
+{
+	double time = std::min(_time, _distribution.m_max);
+	time = std::max(time, _distribution.m_min);
+	return (time != time) ? _distribution.m_min : time;
+}
+
+// x = 2^e * m with m in [sqrt(2)/2, sqrt(2)[, and log(m) = 2 atanh((m-1)/(m+1))
+inline double LognormalSampler::Log(double _x)
+{
+	uint64_t bits = Bits(_x);
+	double m = FromBits((bits & 0x000FFFFFFFFFFFFFull) | 0x3FF0000000000000ull);
+	double e = FromBits((bits >> 52) | 0x4330000000000000ull) - TWO_52 - 1023.0;
+	bool high = m > SQRT2;
+	m = high ? m * 0.5 : m;
+	e = high ? e + 1.0 : e;
+
+	double s = (m - 1.0) / (m + 1.0);
+	double s2 = s * s;
+	double series = 1.0 / 21.0;
+	series = series * s2 + 1.0 / 19.0;
+	series = series * s2 + 1.0 / 17.0;
+	series = series * s2 + 1.0 / 15.0;
+	series = series * s2 + 1.0 / 13.0;
+	series = series * s2 + 1.0 / 11.0;
+	series = series * s2 + 1.0 / 9.0;
+	series = series * s2 + 1.0 / 7.0;
+	series = series * s2 + 1.0 / 5.0;
+	series = series * s2 + 1.0 / 3.0;
+	series = series * s2 + 1.0;
+	return e * LN2_HI + (2.0 * s * series + e * LN2_LO);
+}
+
+// x = k ln(2) + r with |r| <= ln(2)/2, and exp(x) = 2^k exp(r)
+inline double LognormalSampler::Exp(double _x)
+{
+	double x = std::min(std::max(_x, -708.0), 709.0);
+	double k = (x * LOG2E + ROUND_MAGIC) - ROUND_MAGIC;
+	double r = (x - k * LN2_HI) - k * LN2_LO;
+
+	double series = 1.0 / 6227020800.0;
+	series = series * r + 1.0 / 479001600.0;
+	series = series * r + 1.0 / 39916800.0;
+	series = series * r + 1.0 / 3628800.0;
+	series = series * r + 1.0 / 362880.0;
+	series = series * r + 1.0 / 40320.0;
+	series = series * r + 1.0 / 5040.0;
+	series = series * r + 1.0 / 720.0;
+	series = series * r + 1.0 / 120.0;
+	series = series * r + 1.0 / 24.0;
+	series = series * r + 1.0 / 6.0;
+	series = series * r + 0.5;
+	series = series * r + 1.0;
+	series = series * r + 1.0;
+
+	double scale = FromBits(Bits(k + 1023.0 + TWO_52) << 52);
+	return series * scale;
+}
+
+// 2*PI*x = q*PI/2 + a with |a| <= PI/4: cos, -sin, -cos or sin of a, depending on the quadrant q
+inline double LognormalSampler::Cos2Pi(double _x)
+{
+	double t = 4.0 * _x;
+	double q = (t + ROUND_MAGIC) - ROUND_MAGIC;
+	double a = (t - q) * HALF_PI;
+	q = (q == 4.0) ? 0.0 : q;
+	double a2 = a * a;
+
+	double cosine = 1.0 / 20922789888000.0;
+	cosine = cosine * a2 - 1.0 / 87178291200.0;
+	cosine = cosine * a2 + 1.0 / 479001600.0;
+	cosine = cosine * a2 - 1.0 / 3628800.0;
+	cosine = cosine * a2 + 1.0 / 40320.0;
+	cosine = cosine * a2 - 1.0 / 720.0;
+	cosine = cosine * a2 + 1.0 / 24.0;
+	cosine = cosine * a2 - 0.5;
+	cosine = cosine * a2 + 1.0;
+
+	double sine = 1.0 / 355687428096000.0;
+	sine = sine * a2 - 1.0 / 1307674368000.0;
+	sine = sine * a2 + 1.0 / 6227020800.0;
+	sine = sine * a2 - 1.0 / 39916800.0;
+	sine = sine * a2 + 1.0 / 362880.0;
+	sine = sine * a2 - 1.0 / 5040.0;
+	sine = sine * a2 + 1.0 / 120.0;
+	sine = sine * a2 - 1.0 / 6.0;
+	sine = sine * a2 + 1.0;
+	sine = sine * a;
+
+	double value = (q == 0.0) ? cosine : -sine;
+	value = (q == 2.0) ? -cosine : value;
+	return (q == 3.0) ? sine : value;
+}
+
+void LognormalSampler::SampleLegacy(const TimeDistribution& _distribution, std::minstd_rand0& _generator, int _steps, double* _times)
+{
+	std::lognormal_distribution<double> distribution(_distribution.m_meanLog, _distribution.m_stdDevLog);
+	for (int j = 0; j < _steps; j++)
+	{
+		_times[j] = Clamp(distribution(_generator), _distribution);
+	}
+}
+
+void LognormalSampler::SampleCounter(const TimeDistribution& _distribution, const CounterRng& _rng, int _task, int _frame, int _steps, double* _times)
+{
+	const int BATCH = CounterRng::BATCH;
+	const TimeDistribution distribution = _distribution;
+	int j = 0;
+	for (; j + BATCH <= _steps; j += BATCH)
+	{
+		double u1[BATCH], u2[BATCH];
+		_rng.UniformBatch(j, _task, _frame, CounterRng::EXECUTION_TIME, u1, u2);
+		// Box-Muller, then the lognormal time
+		double times[BATCH];
+		for (int k = 0; k < BATCH; k++)
+		{
+			double normal = std::sqrt(-2.0 * Log(u1[k])) * Cos2Pi(u2[k]);
+			times[k] = Clamp(Exp(distribution.m_meanLog + distribution.m_stdDevLog * normal), distribution);
+		}
+		std::copy(times, times + BATCH, _times + j);
+	}
+	for (; j < _steps; j++)
+	{
+		_times[j] = SampleCounterStep(_distribution, _rng, j, _task, _frame);
+	}
+}
+
+double LognormalSampler::SampleCounterStep(const TimeDistribution& _distribution, const CounterRng& _rng, int _step, int _task, int _frame)
+{
+	double u1, u2;
+	_rng.Uniforms(_step, _task, _frame, CounterRng::EXECUTION_TIME, u1, u2);
+	double normal = std::sqrt(-2.0 * Log(u1)) * Cos2Pi(u2);
+	return Clamp(Exp(_distribution.m_meanLog + _distribution.m_stdDevLog * normal), _distribution);
+}
+
+// The longest of n steps is below the quantile p with probability p^n: its quantile _longest is the quantile
+// _longest^(1/n) of a step. The other steps are then independent and uniform below it.
+void LognormalSampler::SampleLongest(const TimeDistribution& _distribution, const CounterRng& _rng, double _longest, bool _antithetic, int _task, int _frame, int _steps, double* _times)
+{
+	double top = std::pow(_longest, 1.0 / _steps);
+	int longestStep = std::min(_steps - 1, (int)(_rng.Uniform(0, _task, _frame, CounterRng::LONGEST_STEP) * _steps));
+	for (int j = 0; j < _steps; j++)
+	{
+		double u = _rng.Uniform(j, _task, _frame, CounterRng::EXECUTION_TIME);
+		u = (j == longestStep) ? top : top * (_antithetic ? 1.0 - u : u);
+		_times[j] = Clamp(Exp(_distribution.m_meanLog + _distribution.m_stdDevLog * Statistics::NormalQuantile(u)), _distribution);
+	}
+}
+
+double LognormalSampler::LongestQuantile(const TimeDistribution& _distribution, int _steps, double _p)
+{
+	return Clamp(Exp(_distribution.m_meanLog + _distribution.m_stdDevLog * Statistics::NormalQuantile(std::pow(_p, 1.0 / _steps))), _distribution);
+}
+
+double LognormalSampler::LongestUniform(const CounterRng& _rng, int _task, int _frame)
+{
+	return _rng.Uniform(1, _task, _frame, CounterRng::LONGEST_STEP);
+}
+
+// A permutation of the LATIN_HYPERCUBE_SEEDS strata for each task, from one uniform number read as a
+// Lehmer code: the points of a replicate put the longest step of the task once in each stratum, in an
+// order independent from the other tasks. The place in the stratum is drawn with _rng.
+double LognormalSampler::LatinHypercubeLongest(const CounterRng& _permutations, const CounterRng& _rng, int _point, int _task, int _frame)
+{
+	static_assert(LATIN_HYPERCUBE_SEEDS <= 16, "the Lehmer code of a permutation must fit in the 53 bits of a uniform number");
+	double code = std::floor(_permutations.Uniform(0, _task, _frame, CounterRng::LATIN_HYPERCUBE_PERMUTATION) * FACTORIAL[LATIN_HYPERCUBE_SEEDS]);
+	int strata[LATIN_HYPERCUBE_SEEDS];
+	for (int k = 0; k < LATIN_HYPERCUBE_SEEDS; k++)
+	{
+		strata[k] = k;
+	}
+	int stratum = 0;
+	for (int k = 0; k <= _point; k++)
+	{
+		double left = LATIN_HYPERCUBE_SEEDS - k;
+		int index = k + (int)std::fmod(code, left);
+		code = std::floor(code / left);
+		std::swap(strata[k], strata[index]);
+		stratum = strata[k];
+	}
+	return (stratum + LongestUniform(_rng, _task, _frame)) / LATIN_HYPERCUBE_SEEDS;
+}
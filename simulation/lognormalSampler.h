@@ -0,0 +1,45 @@
+#pragma once
+
+#include <random>
+#include "counterRng.h"
+#include "../tasks/task.h"
+
+// Draws the execution times of the steps of a task in a frame, clamped to the bounds of the
+// distribution, into a slice of the SampleStore.
+// The counter-based times are computed by batches of CounterRng::BATCH steps, with exp, log and
+// cos written as plain arithmetic so that the compiler vectorizes the loops; the steps left after
+// the last batch use the scalar version of the same arithmetic and get the same values.
+class LognormalSampler
+{
+public:
+	//SAME TIMES AS THE ORIGINAL SAMPLING WITH std::lognormal_distribution
+	static void SampleLegacy(const TimeDistribution& _distribution, std::minstd_rand0& _generator, int _steps, double* _times);
+
+	//COUNTER-BASED TIMES OF STEPS 0 TO _steps-1
+	static void SampleCounter(const TimeDistribution& _distribution, const CounterRng& _rng, int _task, int _frame, int _steps, double* _times);
+
+	//COUNTER-BASED TIME OF ONE STEP, ONE NUMBER AT A TIME
+	static double SampleCounterStep(const TimeDistribution& _distribution, const CounterRng& _rng, int _step, int _task, int _frame);
+
+	//COUNTER-BASED TIMES OF STEPS 0 TO _steps-1, THE LONGEST ONE AT THE QUANTILE _longest OF THE LONGEST OF _steps
+	//TIMES: WITH _antithetic, THE OTHER STEPS USE 1-u INSTEAD OF THE UNIFORM NUMBER u DRAWN FOR THEM
+	static void SampleLongest(const TimeDistribution& _distribution, const CounterRng& _rng, double _longest, bool _antithetic, int _task, int _frame, int _steps, double* _times);
+
+	//TIME OF THE LONGEST OF _steps STEPS AT ITS QUANTILE _p
+	static double LongestQuantile(const TimeDistribution& _distribution, int _steps, double _p);
+
+	//UNIFORM NUMBER OF THE QUANTILE OF THE LONGEST STEP OF A TASK IN A FRAME
+	static double LongestUniform(const CounterRng& _rng, int _task, int _frame);
+
+	//QUANTILE OF THE LONGEST STEP FOR POINT _point OF A REPLICATE OF LATIN_HYPERCUBE_SEEDS POINTS: IN A STRATUM OF
+	//EQUAL PROBABILITY, WITH THE STRATA OF THE TASK PERMUTED BY _permutations (THE SAME FOR THE REPLICATE)
+	static double LatinHypercubeLongest(const CounterRng& _permutations, const CounterRng& _rng, int _point, int _task, int _frame);
+
+private:
+	static double Clamp(double _time, const TimeDistribution& _distribution);
+
+	//VECTORIZABLE MATH: Log FOR x IN ]0,1], Exp, AND cos(2*PI*x) FOR x IN [0,1]
+	static double Log(double _x);
+	static double Exp(double _x);
+	static double Cos2Pi(double _x);
+};
@@ -0,0 +1,105 @@
+#include <stdafx.h>
+#include <cmath>
+#include <fstream>
+
+#include "metricsSummary.h"
+
+namespace
+{
+	// SF, DF, CS and mean frame of a simulation
+	const int NB_METRICS = 4;
+
+	void GetValues(const FrameMetrics& _metrics, double* _values)
+	{
+		_values[0] = _metrics.GetSlowestFrame();
+		_values[1] = _metrics.m_delayedFrames;
+		_values[2] = _metrics.m_cumulativeSlowdown;
+		_values[3] = _metrics.GetMeanFrame();
+	}
+
+	// A metric that is not available, as SF under importance sampling, is written as -
+	void WriteValue(std::ostream& _file, double _value)
+	{
+		if (std::isnan(_value))
+		{
+			_file << " -";
+		}
+		else
+		{
+			_file << " " << _value;
+		}
+	}
+
+	void WriteValues(std::ostream& _file, const double* _values, const FrameHistogram& _durations)
+	{
+		for (int i = 0; i < NB_METRICS; i++)
+		{
+			WriteValue(_file, _values[i]);
+		}
+		_file << " " << _durations.GetQuantile(0.50) << " " << _durations.GetQuantile(0.95) << " " << _durations.GetQuantile(0.99);
+	}
+}
+
+const char* MetricsSummary::BASELINE = "FIFO";
+
+void MetricsSummary::Add(int _nbWorkers, const std::string& _method, int _seed, const FrameMetrics& _metrics)
+{
+	m_runs[Configuration(_nbWorkers, _method)][_seed] = _metrics;
+}
+
+void MetricsSummary::Write(const std::string& _folder) const
+{
+	std::ofstream summary(_folder + "/Summary.txt");
+	std::ofstream seeds(_folder + "/SummarySeeds.txt");
+	for (const auto& run : m_runs)
+	{
+		int nbWorkers = run.first.first;
+		const std::string& method = run.first.second;
+		auto baseline = m_runs.find(Configuration(nbWorkers, BASELINE));
+
+		FrameHistogram durations;
+		double means[NB_METRICS] = { 0.0 };
+		double differences[NB_METRICS] = { 0.0 };
+		int nbPaired = 0;
+		for (const auto& seed : run.second)
+		{
+			double values[NB_METRICS];
+			GetValues(seed.second, values);
+			seeds << nbWorkers << " " << method << " " << seed.first;
+			WriteValues(seeds, values, seed.second.m_durations);
+			seeds << "\n";
+
+			durations.Merge(seed.second.m_durations);
+			for (int i = 0; i < NB_METRICS; i++)
+			{
+				means[i] += values[i] / run.second.size();
+			}
+			if (baseline == m_runs.end() || baseline->second.count(seed.first) == 0)
+			{
+				continue;
+			}
+			double baselineValues[NB_METRICS];
+			GetValues(baseline->second.at(seed.first), baselineValues);
+			for (int i = 0; i < NB_METRICS; i++)
+			{
+				differences[i] += values[i] - baselineValues[i];
+			}
+			nbPaired++;
+		}
+
+		summary << nbWorkers << " " << method << " " << run.second.size();
+		WriteValues(summary, means, durations);
+		for (int i = 0; i < NB_METRICS; i++)
+		{
+			if (nbPaired > 0)
+			{
+				WriteValue(summary, differences[i] / nbPaired);
+			}
+			else
+			{
+				summary << " -";
+			}
+		}
+		summary << "\n";
+	}
+}
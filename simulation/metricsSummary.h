@@ -0,0 +1,30 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <utility>
+#include "frameMetrics.h"
+
+// Metrics of all the simulations of a sweep, kept in memory as the simulations end, for the
+// (workers, method, seed) and (workers, method) tables written at the end of the sweep.
+// The quantiles of a (workers, method) configuration are those of the frames of all its seeds,
+// from the merged histograms; its SF, DF, CS and mean frame are the means over its seeds.
+class MetricsSummary
+{
+public:
+	//METHOD THE OTHER METHODS ARE COMPARED TO, AS IN THE ARTICLE
+	static const char* BASELINE;
+
+	//METRICS OF THE SIMULATION OF _method ON _nbWorkers WORKERS WITH SEED _seed
+	void Add(int _nbWorkers, const std::string& _method, int _seed, const FrameMetrics& _metrics);
+
+	//_folder/Summary.txt: ONE LINE PER (WORKERS, METHOD): WORKERS, METHOD, SEEDS, SF, DF, CS, MEAN FRAME, P50, P95 AND
+	//P99, THEN THE MEAN DIFFERENCES OF SF, DF, CS AND MEAN FRAME WITH THE BASELINE ON THE SAME SEEDS ("-" WITHOUT IT).
+	//_folder/SummarySeeds.txt: ONE LINE PER (WORKERS, METHOD, SEED): WORKERS, METHOD, SEED, SF, DF, CS, MEAN FRAME, P50, P95, P99
+	void Write(const std::string& _folder) const;
+
+private:
+	typedef std::pair<int, std::string> Configuration;
+
+	std::map<Configuration, std::map<int, FrameMetrics>> m_runs; // by seed
+};
@@ -0,0 +1,204 @@
+#include <stdafx.h>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "sampleCache.h"
+#include "simulationUtils.h"
+
+namespace
+{
+	const char MAGIC[8] = { 'S', 'A', 'M', 'P', 'L', 'E', 'S', '\0' };
+
+	// FNV-1a
+	struct Hash
+	{
+		uint64_t m_value = 14695981039346656037ull;
+
+		void Add(const void* _data, size_t _size)
+		{
+			const unsigned char* bytes = (const unsigned char*)_data;
+			for (size_t i = 0; i < _size; i++)
+			{
+				m_value = (m_value ^ bytes[i]) * 1099511628211ull;
+			}
+		}
+
+		template <class T>
+		void Add(const T& _value)
+		{
+			Add(&_value, sizeof(_value));
+		}
+	};
+}
+
+const uint64_t SampleCache::VERSION;
+
+size_t SampleCache::FileSize(const Header& _header)
+{
+	size_t nbSlots = (size_t)_header.m_nbFrames * _header.m_nbTasks;
+	return sizeof(Header) + (nbSlots + 1) * sizeof(uint64_t) + _header.m_nbTimes * sizeof(double)
+		+ nbSlots * sizeof(TimeTotals) + _header.m_nbFrames * sizeof(double);
+}
+
+void SampleCache::GetTimes(SimulationParameters& _parameters, int _nbThreads)
+{
+	// The files do not keep the likelihood ratios of the frames
+	if (_parameters.SampleCacheFolder.empty() || _parameters.ImportanceShift != 0.0)
+	{
+		SimulationUtils::ExecutionTimeControl(_parameters, _nbThreads);
+		return;
+	}
+
+	uint64_t key = Key(_parameters);
+	std::string fileName = FileName(_parameters, key);
+
+	// Jobs of the same seed wait for the first one to write the file instead of drawing the times again
+	static std::mutex mapMutex;
+	static std::map<uint64_t, std::shared_ptr<std::mutex>> keyMutexes;
+	std::shared_ptr<std::mutex> keyMutex;
+	{
+		std::lock_guard<std::mutex> lock(mapMutex);
+		std::shared_ptr<std::mutex>& entry = keyMutexes[key];
+		if (!entry)
+		{
+			entry = std::make_shared<std::mutex>();
+		}
+		keyMutex = entry;
+	}
+	std::lock_guard<std::mutex> lock(*keyMutex);
+
+	if (Load(_parameters, fileName, key))
+	{
+		return;
+	}
+	SimulationUtils::ExecutionTimeControl(_parameters, _nbThreads);
+	if (Save(_parameters, fileName, key))
+	{
+		// The jobs share the pages of the file instead of keeping their own copy
+		Load(_parameters, fileName, key);
+	}
+}
+
+uint64_t SampleCache::Key(const SimulationParameters& _parameters)
+{
+	Hash hash;
+	hash.Add(VERSION);
+	hash.Add(_parameters.m_seed);
+	hash.Add(_parameters.m_iNbFrames);
+	hash.Add(_parameters.IsDivided);
+	hash.Add(_parameters.SortingSteps);
+	hash.Add(_parameters.CounterRng);
+	// The times of a seed only depend on the first seed with antithetic or Latin hypercube draws
+	if (_parameters.Sampling != SamplingMode::PLAIN)
+	{
+		hash.Add(_parameters.Sampling);
+		hash.Add(_parameters.m_startSeed);
+	}
+	hash.Add(_parameters.m_lags.data(), _parameters.m_lags.size() * sizeof(double));
+	// The steps and distributions are linear in the lag: the values without and with full lag define them
+	for (Task* task : _parameters.m_sequence.GetTasks())
+	{
+		hash.Add(task->GetName().data(), task->GetName().size());
+		hash.Add(task->GetIndex());
+		hash.Add(task->GetTopoOrder());
+		for (double lag : { 0.0, 1.0 })
+		{
+			hash.Add(task->GetStep(lag));
+			TimeDistribution distribution = task->GenerateTime(lag);
+			hash.Add(distribution.m_meanLog);
+			hash.Add(distribution.m_stdDevLog);
+			hash.Add(distribution.m_max);
+			hash.Add(distribution.m_min);
+		}
+	}
+	return hash.m_value;
+}
+
+std::string SampleCache::FileName(const SimulationParameters& _parameters, uint64_t _key)
+{
+	std::ostringstream name;
+	name << _parameters.SampleCacheFolder << "/samples_" << std::hex << _key << ".bin";
+	return name.str();
+}
+
+bool SampleCache::Load(SimulationParameters& _parameters, const std::string& _fileName, uint64_t _key)
+{
+	int file = open(_fileName.c_str(), O_RDONLY);
+	if (file < 0)
+	{
+		return false;
+	}
+	struct stat status;
+	bool ok = fstat(file, &status) == 0 && (size_t)status.st_size >= sizeof(Header);
+	void* data = ok ? mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, file, 0) : MAP_FAILED;
+	close(file);
+	if (data == MAP_FAILED)
+	{
+		return false;
+	}
+	size_t size = status.st_size;
+	std::shared_ptr<const void> mapping(data, [size](const void* _data) { munmap((void*)_data, size); });
+
+	const Header* header = (const Header*)data;
+	size_t nbSlots = (size_t)header->m_nbFrames * header->m_nbTasks;
+	if (std::memcmp(header->m_magic, MAGIC, sizeof(MAGIC)) != 0 || header->m_version != VERSION || header->m_key != _key
+		|| header->m_nbFrames != _parameters.m_iNbFrames || header->m_nbTasks != (int32_t)_parameters.m_sequence.GetTasks().size()
+		|| size != FileSize(*header))
+	{
+		return false;
+	}
+	const uint64_t* offsets = (const uint64_t*)(header + 1);
+	const double* times = (const double*)(offsets + nbSlots + 1);
+	const TimeTotals* totals = (const TimeTotals*)(times + header->m_nbTimes);
+	const double* frameTotals = (const double*)(totals + nbSlots);
+	_parameters.m_times.View(header->m_nbFrames, header->m_nbTasks, offsets, times, totals, frameTotals, mapping);
+	return true;
+}
+
+// Written to a temporary file first: other processes never map a partial file
+bool SampleCache::Save(const SimulationParameters& _parameters, const std::string& _fileName, uint64_t _key)
+{
+	const SampleStore& store = _parameters.m_times;
+	Header header;
+	std::memcpy(header.m_magic, MAGIC, sizeof(MAGIC));
+	header.m_version = VERSION;
+	header.m_key = _key;
+	header.m_nbFrames = store.GetFrameCount();
+	header.m_nbTasks = store.GetTaskCount();
+	header.m_nbTimes = store.GetTimeCount();
+
+	if (system(("mkdir -p " + _parameters.SampleCacheFolder).c_str()) != 0)
+	{
+		std::cerr << "Warning: cannot create the folder " << _parameters.SampleCacheFolder << "\n";
+		return false;
+	}
+	std::ostringstream temporaryName;
+	temporaryName << _fileName << ".tmp" << getpid() << "_" << std::this_thread::get_id();
+	FILE* file = fopen(temporaryName.str().c_str(), "wb");
+	if (file == nullptr)
+	{
+		std::cerr << "Warning: cannot write the sample cache " << _fileName << "\n";
+		return false;
+	}
+	size_t nbSlots = (size_t)header.m_nbFrames * header.m_nbTasks;
+	bool ok = fwrite(&header, sizeof(header), 1, file) == 1
+		&& fwrite(store.GetOffsets(), sizeof(uint64_t), nbSlots + 1, file) == nbSlots + 1
+		&& fwrite(store.GetAllTimes(), sizeof(double), header.m_nbTimes, file) == header.m_nbTimes
+		&& fwrite(store.GetAllTotals(), sizeof(TimeTotals), nbSlots, file) == nbSlots
+		&& fwrite(store.GetFrameTotals(), sizeof(double), header.m_nbFrames, file) == (size_t)header.m_nbFrames;
+	ok = (fclose(file) == 0) && ok;
+	if (!ok || rename(temporaryName.str().c_str(), _fileName.c_str()) != 0)
+	{
+		std::cerr << "Warning: cannot write the sample cache " << _fileName << "\n";
+		remove(temporaryName.str().c_str());
+		return false;
+	}
+	return true;
+}
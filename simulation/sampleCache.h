@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "simulation.h"
+
+// Execution times saved on disk, one file per (graph, seed, frames, IsDivided, SortingSteps, RNG),
+// in the folder given by SimulationParameters::SampleCache.
+// A file is written once and then mapped read-only by every job and every process needing
+// the same times, so that reruns and partial sweeps skip the sampling.
+// The file keeps the offsets, the times, then the totals of every slice and of every frame:
+// a mapped file needs no pass over its times.
+class SampleCache
+{
+public:
+	//FILL _parameters.m_times: MAPPED FROM THE CACHE IF THE FILE EXISTS, ELSE DRAWN WITH
+	//SimulationUtils::ExecutionTimeControl (USING UP TO _nbThreads THREADS) AND SAVED
+	static void GetTimes(SimulationParameters& _parameters, int _nbThreads);
+
+	//HASH OF EVERYTHING THE EXECUTION TIMES DEPEND ON
+	static uint64_t Key(const SimulationParameters& _parameters);
+
+	static std::string FileName(const SimulationParameters& _parameters, uint64_t _key);
+	static bool Load(SimulationParameters& _parameters, const std::string& _fileName, uint64_t _key);
+	static bool Save(const SimulationParameters& _parameters, const std::string& _fileName, uint64_t _key);
+
+private:
+	// Bump when the sampling changes: the old files are then ignored
+	static const uint64_t VERSION = 2;
+
+	struct Header
+	{
+		char m_magic[8];
+		uint64_t m_version;
+		uint64_t m_key;
+		int32_t m_nbFrames;
+		int32_t m_nbTasks;
+		uint64_t m_nbTimes;
+	};
+
+	//SIZE OF THE FILE DESCRIBED BY _header
+	static size_t FileSize(const Header& _header);
+};
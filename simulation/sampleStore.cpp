@@ -0,0 +1,150 @@
+#include <stdafx.h>
+
+#include "sampleStore.h"
+
+namespace
+{
+	// Data of a copied store: its own vector when the original used its own, else the same outside data
+	template <class T>
+	const T* CopiedData(const T* _data, const std::vector<T>& _from, const std::vector<T>& _to)
+	{
+		return (_data == _from.data()) ? _to.data() : _data;
+	}
+}
+
+SampleStore::SampleStore()
+{
+	Clear(0, 0);
+}
+
+// The pointers to the owned vectors are kept up to date: a copied store points to its own vectors
+SampleStore::SampleStore(const SampleStore& _store)
+{
+	*this = _store;
+}
+
+SampleStore& SampleStore::operator=(const SampleStore& _store)
+{
+	m_nbFrames = _store.m_nbFrames;
+	m_nbTasks = _store.m_nbTasks;
+	m_offsets = _store.m_offsets;
+	m_times = _store.m_times;
+	m_mapping = _store.m_mapping;
+	m_totals = _store.m_totals;
+	m_frameTotals = _store.m_frameTotals;
+	m_logWeights = _store.m_logWeights;
+	m_offsetData = CopiedData(_store.m_offsetData, _store.m_offsets, m_offsets);
+	m_timeData = CopiedData(_store.m_timeData, _store.m_times, m_times);
+	m_totalData = CopiedData(_store.m_totalData, _store.m_totals, m_totals);
+	m_frameTotalData = CopiedData(_store.m_frameTotalData, _store.m_frameTotals, m_frameTotals);
+	m_logWeightData = CopiedData(_store.m_logWeightData, _store.m_logWeights, m_logWeights);
+	return *this;
+}
+
+// Moved vectors keep their buffers: the pointers to them stay valid
+SampleStore::SampleStore(SampleStore&& _store)
+	: m_nbFrames(_store.m_nbFrames), m_nbTasks(_store.m_nbTasks), m_offsets(std::move(_store.m_offsets)), m_times(std::move(_store.m_times)),
+	m_totals(std::move(_store.m_totals)), m_frameTotals(std::move(_store.m_frameTotals)), m_logWeights(std::move(_store.m_logWeights)),
+	m_offsetData(_store.m_offsetData), m_timeData(_store.m_timeData), m_totalData(_store.m_totalData), m_frameTotalData(_store.m_frameTotalData),
+	m_logWeightData(_store.m_logWeightData), m_mapping(std::move(_store.m_mapping))
+{
+	_store.Clear(0, 0);
+}
+
+void SampleStore::Clear(int _nbFrames, int _nbTasks)
+{
+	m_nbFrames = _nbFrames;
+	m_nbTasks = _nbTasks;
+	m_mapping.reset();
+	m_offsets.clear();
+	m_offsets.reserve((size_t)_nbFrames * _nbTasks + 1);
+	m_offsets.push_back(0);
+	m_times.clear();
+	m_totals.clear();
+	m_frameTotals.clear();
+	m_logWeights.assign(_nbFrames, 0.0);
+	m_offsetData = m_offsets.data();
+	m_timeData = m_times.data();
+	m_totalData = nullptr;
+	m_frameTotalData = nullptr;
+	m_logWeightData = m_logWeights.empty() ? nullptr : m_logWeights.data();
+}
+
+double* SampleStore::AddSlice(int _count)
+{
+	size_t begin = m_times.size();
+	m_times.resize(begin + _count);
+	m_offsets.push_back(m_times.size());
+	m_offsetData = m_offsets.data();
+	m_timeData = m_times.data();
+	return m_times.data() + begin;
+}
+
+void SampleStore::View(int _nbFrames, int _nbTasks, const uint64_t* _offsets, const double* _times, const TimeTotals* _totals, const double* _frameTotals, std::shared_ptr<const void> _mapping)
+{
+	Clear(0, 0);
+	m_nbFrames = _nbFrames;
+	m_nbTasks = _nbTasks;
+	m_offsetData = _offsets;
+	m_timeData = _times;
+	m_totalData = _totals;
+	m_frameTotalData = _frameTotals;
+	m_mapping = _mapping;
+}
+
+// The shared store stays as it is: its data is not copied
+void SampleStore::Share(std::shared_ptr<const SampleStore> _store)
+{
+	Clear(0, 0);
+	m_nbFrames = _store->m_nbFrames;
+	m_nbTasks = _store->m_nbTasks;
+	m_offsetData = _store->m_offsetData;
+	m_timeData = _store->m_timeData;
+	m_totalData = _store->m_totalData;
+	m_frameTotalData = _store->m_frameTotalData;
+	m_logWeightData = _store->m_logWeightData;
+	m_mapping = _store;
+}
+
+void SampleStore::ComputeTotals(const std::vector<int>& _taskOrder)
+{
+	size_t nbSlots = (size_t)m_nbFrames * m_nbTasks;
+	m_totals.resize(nbSlots);
+	for (size_t slot = 0; slot < nbSlots; slot++)
+	{
+		m_totals[slot] = Totals(m_timeData + m_offsetData[slot], m_offsetData[slot + 1] - m_offsetData[slot]);
+	}
+	// Added time after time rather than task sum after task sum, as in the TotalExecution files
+	m_frameTotals.assign(m_nbFrames, 0.0);
+	for (int frame = 0; frame < m_nbFrames; frame++)
+	{
+		double total = 0.0;
+		for (int task : _taskOrder)
+		{
+			const double* times = GetTimes(frame, task);
+			for (int i = 0; i < GetCount(frame, task); i++)
+			{
+				total += times[i];
+			}
+		}
+		m_frameTotals[frame] = total;
+	}
+	m_totalData = m_totals.data();
+	m_frameTotalData = m_frameTotals.data();
+}
+
+TimeTotals SampleStore::Totals(const double* _times, int _count)
+{
+	TimeTotals totals = { 0.0, 0.0, 0 };
+	for (int i = 0; i < _count; i++)
+	{
+		totals.m_sum += _times[i];
+		totals.m_longest = std::max(totals.m_longest, _times[i]);
+		// A step without time, as a task without mean time under lag, is done from the start
+		if (_times[i] > 0.0)
+		{
+			totals.m_workSteps++;
+		}
+	}
+	return totals;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "tasks/task.h"
+
+// Execution times of the steps of every task for every frame of a simulation.
+// The times are kept frame after frame, tasks by index, in one buffer: the times of a task
+// in a frame are a contiguous slice found with an offset table.
+// The buffer is either owned by the store, a read-only view of a mapped SampleCache file, or
+// shared with another store along with its totals.
+class SampleStore
+{
+public:
+	SampleStore();
+	SampleStore(const SampleStore& _store);
+	//TAKES THE BUFFERS OF _store, LEFT EMPTY
+	SampleStore(SampleStore&& _store);
+	SampleStore& operator=(const SampleStore& _store);
+
+	//REMOVE ALL THE TIMES AND GET READY FOR _nbFrames FRAMES OF _nbTasks TASKS
+	void Clear(int _nbFrames, int _nbTasks);
+
+	//ADD THE SLICE OF THE NEXT TASK (TASKS BY INDEX, FRAME AFTER FRAME) AND RETURN IT TO BE FILLED;
+	//THE POINTER IS VALID UNTIL THE NEXT SLICE IS ADDED
+	double* AddSlice(int _count);
+
+	//USE TIMES AND TOTALS KEPT OUTSIDE THE STORE: _mapping KEEPS THEM ALIVE
+	void View(int _nbFrames, int _nbTasks, const uint64_t* _offsets, const double* _times, const TimeTotals* _totals, const double* _frameTotals, std::shared_ptr<const void> _mapping);
+	//USE THE TIMES AND TOTALS OF _store, KEPT ALIVE BY THIS STORE
+	void Share(std::shared_ptr<const SampleStore> _store);
+
+	int GetFrameCount() const { return m_nbFrames; };
+	int GetTaskCount() const { return m_nbTasks; };
+
+	//TIMES OF THE STEPS OF TASK _task IN FRAME _frame
+	int GetCount(int _frame, int _task) const { return m_offsetData[Slot(_frame, _task) + 1] - m_offsetData[Slot(_frame, _task)]; };
+	const double* GetTimes(int _frame, int _task) const { return m_timeData + m_offsetData[Slot(_frame, _task)]; };
+	double* GetSlice(int _frame, int _task) { return m_times.data() + m_offsets[Slot(_frame, _task)]; };
+
+	//WHOLE OFFSET TABLE (FRAMES * TASKS + 1 VALUES) AND BUFFER OF TIMES
+	const uint64_t* GetOffsets() const { return m_offsetData; };
+	const double* GetAllTimes() const { return m_timeData; };
+	uint64_t GetTimeCount() const { return m_offsetData[(size_t)m_nbFrames * m_nbTasks]; };
+
+	//TOTALS OF EVERY SLICE, AND TOTAL OF EVERY FRAME ADDING THE TASKS IN _taskOrder:
+	//COMPUTED ONCE WHEN THE TIMES ARE READY
+	void ComputeTotals(const std::vector<int>& _taskOrder);
+	const TimeTotals& GetTotals(int _frame, int _task) const { return m_totalData[Slot(_frame, _task)]; };
+	double GetFrameTotal(int _frame) const { return m_frameTotalData[_frame]; };
+	//WHOLE TABLES OF TOTALS (FRAMES * TASKS AND FRAMES VALUES), ONCE COMPUTED
+	const TimeTotals* GetAllTotals() const { return m_totalData; };
+	const double* GetFrameTotals() const { return m_frameTotalData; };
+
+	//LOG OF THE LIKELIHOOD RATIO OF THE DRAWS OF A FRAME UNDER IMPORTANCE SAMPLING, 0 WITHOUT IT
+	void SetLogWeight(int _frame, double _logWeight) { m_logWeights[_frame] = _logWeight; };
+	double GetLogWeight(int _frame) const { return (m_logWeightData == nullptr) ? 0.0 : m_logWeightData[_frame]; };
+
+	//TOTALS OF _count TIMES, ADDED ONE AFTER THE OTHER
+	static TimeTotals Totals(const double* _times, int _count);
+
+private:
+	size_t Slot(int _frame, int _task) const { return (size_t)_frame * m_nbTasks + _task; };
+
+	int m_nbFrames;
+	int m_nbTasks;
+	std::vector<uint64_t> m_offsets;
+	std::vector<double> m_times;
+	std::vector<TimeTotals> m_totals;
+	std::vector<double> m_frameTotals;
+	std::vector<double> m_logWeights; // empty for the times of a SampleCache file
+	// Owned vectors above, the mapped file, or the data of a shared store
+	const uint64_t* m_offsetData;
+	const double* m_timeData;
+	const TimeTotals* m_totalData;
+	const double* m_frameTotalData;
+	const double* m_logWeightData;
+	std::shared_ptr<const void> m_mapping;
+};
@@ -2,14 +2,19 @@
 #include <fstream>
 #include <string>
 #include <cstring>
+#include <cmath>
 #include "simulation.h"
 #include "profiler/profiler.h"
 #include "device/device.h"
+#include "frameStream.h"
+#include "frameBounds.h"
+#include "steadyState.h"
+#include "scheduler/strategies/strategyRegistry.h"
 
 
-void Simulation::Play(SimulationParameters& _parameters, std::string Strategy)
+FrameMetrics Simulation::Play(SimulationParameters& _parameters, std::string Strategy, int _nbThreads)
 {
-	Profiler::StartProfiling();
+	Profiler::StartProfiling(_parameters.JsonOutput);
 	Device* device = Device::CreateDevice(_parameters.m_iNbWorkers, Strategy,true);
 	double startTimeCurrent;
 	double startTimePrevious;
@@ -17,94 +22,41 @@ void Simulation::Play(SimulationParameters& _parameters, std::string Strategy)
 	double maxLagFrame = 200;
 	double countLagFrame = 1;
 	double lagProportion = 0;
-	TaskSequence sequence= _parameters.m_sequence;
-	std::ofstream fil;
-	fil.open("Result/TotalExecution/TotalExecution_"+std::to_string(_parameters.m_seed)+"_"+std::to_string(_parameters.m_iNbWorkers)+".txt");
+	// State of the tasks for this run; the sequence is shared with the other runs
+	SequenceState state(_parameters.m_sequence);
+	state.WichToAssign(_parameters.mode);
 	std::ofstream myfile;
-	std::string cont;
-	if(_parameters.IsDivided)
-	{
-		cont="_divided_";
-	}
-	else if(_parameters.SortingSteps)
-	{
-		cont="_sorted_";
-	}
-	else if(!_parameters.SortingSteps)
-	{
-		cont="_NonSorted_";
-	}
-	std::string _reportFileName =Strategy+cont+_parameters.mode + "_" +std::to_string(_parameters.m_seed) + "_" +std::to_string(_parameters.m_iNbFrames) + "_" +std::to_string(_parameters.m_iNbWorkers);
-
-	//Path to strategy: Result/Strategy/nbFrame/TXT/_reportFileName.txt
-	char result_txt[100];
-	char result_json[100];
-	strcpy(result_txt,"Result/");
-	strcat(result_txt,Strategy.c_str()); 
-	strcat(result_txt,"/");
-	strcat(result_txt,std::to_string(_parameters.m_iNbWorkers).c_str());
-	strcat(result_txt,"/");
-	strcat(result_txt,std::to_string(_parameters.m_iNbFrames).c_str()); 
-	strcat(result_txt,"/TXT/"); 
-	strcat(result_txt,_reportFileName.c_str()); 
-	strcat(result_txt,".txt");
-	//Path to strategy: Result/Strategy/nbFrame/Json/_reportFileName.json
-	strcpy(result_json,"Result/");
-	strcat(result_json,Strategy.c_str()); 
-	strcat(result_json,"/");
-	strcat(result_json,std::to_string(_parameters.m_iNbWorkers).c_str());
-	strcat(result_json,"/");
-	strcat(result_json,std::to_string(_parameters.m_iNbFrames).c_str()); 
-	strcat(result_json,"/Json/"); 
-	strcat(result_json,_reportFileName.c_str()); 
-	strcat(result_json,".json");
-	//
+	std::string result_txt = GetResultFile(_parameters, Strategy, "TXT", ".txt");
+	std::string result_json = GetResultFile(_parameters, Strategy, "Json", ".json");
 	myfile.open(result_txt);
 	double beg = 0.0;
-	for (int i = 0; i < _parameters.m_lags.size(); i++)
+	FrameStream frames(_parameters, _nbThreads);
+	FrameBounds bounds(_parameters.m_sequence, _parameters.m_iNbWorkers);
+	FrameMetrics metrics;
+	metrics.m_weighted = _parameters.ImportanceShift != 0.0;
+	SteadyState steady(_parameters);
+	int historyFrames = StrategyRegistry::Find(Strategy)->m_historyFrames;
+	for (int i = 0; i < _parameters.m_iNbFrames; i++)
 	{		
-		std::map<std::string, Task*> Map = _parameters.m_sequence.GetTaskMap();
+		frames.Load(i);
+		std::map<std::string, Task*>& Map = _parameters.m_sequence.GetTaskMap();
 		if(Strategy=="Aco"&&i>0)
 		{
 			ACO* Aco=NULL;
 		
-			Aco=new ACO(30,0.4,0.3,0.5,0.3,Map,_parameters.m_iNbWorkers, _parameters.m_lags[i-1]);
+			Aco=new ACO(30,0.4,0.3,0.5,0.3,Map,_parameters.m_iNbWorkers, frames.GetLag(i-1), state);
 			
-			std::map<Task*,int> bestScheduling;
+			std::vector<int> bestScheduling;
 		
 			bestScheduling=Aco->GetBestScheduling();
 			
 			
 			for(auto elem:Map)
 			{
-				elem.second->AddAnt(bestScheduling[elem.second]);
+				state.GetState(elem.second)->AddAnt(bestScheduling[elem.second->GetIndex()]);
 			}	
 		}	
-		double total=0.0;
-		for(auto elem: Map)
-		{
-			for (int j =0 ;j < _parameters.m_times[std::make_pair(i, elem.second)].size();j++)
-			{
-			 	total += _parameters.m_times[std::make_pair(i, elem.second)][j];
-			}
-		}
-		fil<<i<<" "<<total/_parameters.m_iNbWorkers<<std::endl;
-		for (auto elem : Map)
-		{
-			if(i>0)
-			{
-				double PT = 0.0;
-				for (int j =0 ;j < _parameters.m_times[std::make_pair(i-1, elem.second)].size();j++)
-				{
-					PT += _parameters.m_times[std::make_pair(i-1, elem.second)][j];
-				}
-				elem.second->AddPT(PT);  // add the Processing time of task in the previous frame
-				elem.second->AddLS( _parameters.m_times[std::make_pair(i-1, elem.second)][0]); // add the Processing time of the longest step of the task
-			}
-			std::pair<int, Task*> key = std::make_pair(i, elem.second);
-			elem.second->PushInTime(_parameters.m_times[key]); // Add the generated time of the task
-			elem.second->UpdateStepCount(_parameters.m_times[key].size()); // the number of steps in the task
-		}
+		BindFrame(_parameters, frames, state, i);
 		
 		startTimeCurrent = device->GetGlobalClockTime();
 			
@@ -112,52 +64,112 @@ void Simulation::Play(SimulationParameters& _parameters, std::string Strategy)
 		Profiler::GetInstance()->AddKeyFrame(-1, "Frame", "GenericTask", device->GetGlobalClockTime(), Profiler::KEY_EVENT_TYPE::BEGIN, 0, _parameters.m_iNbFrames);
 		std::ofstream mfile;
 			
-		device->PlaySequence(_parameters.m_sequence, _parameters.m_lags[i]);
+		device->PlaySequence(state, frames.GetLag(i));
 		
 		Profiler::GetInstance()->AddKeyFrame(-1, "Frame", "GenericTask", device->GetGlobalClockTime(), Profiler::KEY_EVENT_TYPE::END, 0, _parameters.m_iNbFrames);
 			
 		if (i > 0)
 		{
 			Profiler::GetInstance()->AddKeyFrame(-2, "CriticalPath", "GenericTask", startTimePrevious, Profiler::KEY_EVENT_TYPE::BEGIN, 0, _parameters.m_iNbFrames);
-			Profiler::GetInstance()->AddKeyFrame(-2, "CriticalPath", "GenericTask", startTimePrevious + device->GetBestTime(i), Profiler::KEY_EVENT_TYPE::END, 0, _parameters.m_iNbFrames);
+			Profiler::GetInstance()->AddKeyFrame(-2, "CriticalPath", "GenericTask", startTimePrevious + device->GetBestTime(), Profiler::KEY_EVENT_TYPE::END, 0, _parameters.m_iNbFrames);
 		}
 		startTimePrevious = startTimeCurrent;
-		myfile << i << " " << device->GetGlobalClockTime()- startTimePrevious<<" " <<device->GetBestTime(i)<< " " << _parameters.m_lags[i] << std::endl;
+		myfile << i << " " << device->GetGlobalClockTime()- startTimePrevious<<" " <<device->GetBestTime()<< " " << frames.GetLag(i);
+		if (_parameters.BoundsOutput)
+		{
+			// The tasks still hold the times the frame started with
+			bounds.Compute(state);
+			bounds.Write(myfile, device->GetGlobalClockTime() - startTimePrevious);
+		}
+		double weight = (_parameters.ImportanceShift != 0.0) ? GetFrameWeight(frames, i, historyFrames) : 1.0;
+		if (_parameters.ImportanceShift != 0.0)
+		{
+			myfile << " " << weight;
+		}
+		myfile << std::endl;
+		metrics.Add(device->GetGlobalClockTime() - startTimePrevious, weight);
+		if (_parameters.SteadyStateOutput && steady.Add(frames.GetLag(i), device->GetGlobalClockTime() - startTimePrevious, weight))
+		{
+			break;
+		}
 	}
 	
 	myfile.close();
-	fil.close();
+	if (_parameters.SteadyStateOutput)
+	{
+		steady.Write(GetResultFile(_parameters, Strategy, "Steady", ".txt"));
+		metrics = steady.Estimate(metrics);
+	}
 	Device::DestroyDevice(device);
 	
 	if(_parameters.JsonOutput)
 		Profiler::GetInstance()->DumpReport(result_json);
 	
 	Profiler::StopProfiling();
-	
+	return metrics;
 }
 
-//Another sorting method for steps; sorting in packets
-void Simulation::SLACK(SimulationParameters& _parameters, std::pair<int, Task*> key)
+std::string Simulation::GetResultFile(const SimulationParameters& _parameters, const std::string& Strategy, const std::string& _folder, const std::string& _extension)
 {
-	std::vector<double> vect;
-	int nb = std::ceil(_parameters.m_times[key].size() / _parameters.m_iNbWorkers);
-	std::map<int, std::vector<double>> tuples;
-	std::map<double, int> order;
-	int n = _parameters.m_times[key].size();
-	int worker = _parameters.m_iNbWorkers;
-	if (nb > 4)
+	std::string cont;
+	if(_parameters.IsDivided)
 	{
-		for (int i = 0;i < nb - 1;i++)
-		{
-			tuples[i] = { &_parameters.m_times[key][i*worker], &_parameters.m_times[key][(i + 1)*worker - 1] };
-			order[_parameters.m_times[key][i*worker] - _parameters.m_times[key][(i + 1)*worker - 1]] = i;
-		}
-		tuples[nb - 1] = { &_parameters.m_times[key][(nb - 1)*worker], &_parameters.m_times[key][_parameters.m_times[key].size() - 1] };
-		order[_parameters.m_times[key][(nb - 1)*worker] - _parameters.m_times[key][_parameters.m_times[key].size() - 1]] = nb - 1;
-		for (auto iter = order.rbegin();iter != order.rend();++iter)
+		cont="_divided_";
+	}
+	else if(_parameters.SortingSteps)
+	{
+		cont="_sorted_";
+	}
+	else if(!_parameters.SortingSteps)
+	{
+		cont="_NonSorted_";
+	}
+	std::string _reportFileName =Strategy+cont+_parameters.mode + "_" +std::to_string(_parameters.m_seed) + "_" +std::to_string(_parameters.m_iNbFrames) + "_" +std::to_string(_parameters.m_iNbWorkers);
+
+	//Path to strategy: Result/Strategy/nbWorkers/nbFrame/_folder/_reportFileName_extension
+	return "Result/" + Strategy + "/" + std::to_string(_parameters.m_iNbWorkers) + "/" + std::to_string(_parameters.m_iNbFrames) + "/" + _folder + "/" + _reportFileName + _extension;
+}
+
+// The tasks read the times in place: nothing is copied for a frame
+void Simulation::BindFrame(SimulationParameters& _parameters, const FrameStream& _frames, SequenceState& _state, int _frame)
+{
+	for (Task* elem : _parameters.m_sequence.GetTasks())
+	{
+		TaskState* task = _state.GetState(elem);
+		int index = elem->GetIndex();
+		if(_frame>0)
 		{
-			vect.insert(vect.end(), tuples[iter->second].begin(), tuples[iter->second].end());
+			task->AddPT(_frames.GetTotals(_frame-1, index).m_sum);  // add the Processing time of task in the previous frame
+			task->AddLS(_frames.GetTimes(_frame-1, index)[0]); // add the Processing time of the longest step of the task
 		}
-		_parameters.m_times[key] = vect;
+		task->PushInTime(_frames.GetTimes(_frame, index), _frames.GetCount(_frame, index), _frames.GetTotals(_frame, index)); // Add the generated time of the task
+		task->UpdateStepCount(_frames.GetCount(_frame, index)); // the number of steps in the task
+	}
+}
+
+// The duration of a frame depends on its times and on those of the frames read by the strategy:
+// the weight covers these frames only, since each tilted frame adds to the variance of the weight
+double Simulation::GetFrameWeight(const FrameStream& _frames, int _frame, int _historyFrames)
+{
+	int first = (_historyFrames == HISTORY_ALL) ? 0 : std::max(0, _frame - _historyFrames);
+	double logWeight = 0.0;
+	for (int i = first; i <= _frame; i++)
+	{
+		logWeight += _frames.GetLogWeight(i);
 	}
+	return std::exp(logWeight);
+}
+
+//Total execution time of each frame divided by the number of workers: Result/TotalExecution/TotalExecution_seed_workers.txt
+void Simulation::DumpTotalExecution(SimulationParameters& _parameters, int _nbThreads)
+{
+	std::ofstream fil;
+	fil.open("Result/TotalExecution/TotalExecution_"+std::to_string(_parameters.m_seed)+"_"+std::to_string(_parameters.m_iNbWorkers)+".txt");
+	FrameStream frames(_parameters, _nbThreads);
+	for (int i = 0; i < _parameters.m_iNbFrames; i++)
+	{
+		frames.Load(i);
+		fil<<i<<" "<<frames.GetFrameTotal(i)/_parameters.m_iNbWorkers<<std::endl;
+	}
+	fil.close();
 }
@@ -3,6 +3,15 @@
 #include <string>
 #include "ACO.h"
 #include "tasks/taskSequence.h"
+#include "tasks/sequenceState.h"
+#include "sampleStore.h"
+#include "frameMetrics.h"
+
+//DRAWS OF THE COUNTER-BASED TIMES: INDEPENDENT SEEDS, ANTITHETIC PAIRS OF SEEDS, OR LATIN HYPERCUBES OF SEEDS
+enum class SamplingMode { PLAIN, ANTITHETIC, LATIN_HYPERCUBE };
+
+//SEEDS OF A LATIN HYPERCUBE REPLICATE: THE STRATA OF THE LONGEST STEP OF EACH TASK
+const int LATIN_HYPERCUBE_SEEDS = 8;
 
 struct SimulationParameters
 {
@@ -11,9 +20,10 @@ struct SimulationParameters
 
     TaskSequence m_sequence;
 
-	std::map<int, double> m_lags;
+	std::vector<double> m_lags;
 
-	std::map<std::pair<int, Task*>, std::vector<double>> m_times;
+	//EXECUTION TIMES OF THE STEPS, BY FRAME AND TASK INDEX
+	SampleStore m_times;
 
 	std::string mode;
 
@@ -31,20 +41,64 @@ struct SimulationParameters
 	bool JsonOutput;
 
 	bool SortingSteps;
-	inline SimulationParameters& operator=(const SimulationParameters& a)
-	{
-		m_iNbFrames = a.m_iNbFrames;
-		m_iNbWorkers = a.m_iNbWorkers;
-		m_sequence = a.m_sequence;
-		return *this;
-	}
+
+	//DRAW THE TIMES AND LAGS WITH THE COUNTER-BASED GENERATOR INSTEAD OF THE LEGACY SEEDING
+	bool CounterRng;
+
+	//WITH ANTITHETIC, SEEDS m_startSeed+2k AND m_startSeed+2k+1 SHARE THEIR NUMBERS, THE SECOND ONE WITH THE
+	//QUANTILES OF THE LONGEST STEPS MIRRORED. WITH LATIN_HYPERCUBE, THE SEEDS GO BY REPLICATES OF LATIN_HYPERCUBE_SEEDS:
+	//SEED i OF A REPLICATE DRAWS THE LONGEST STEP OF EACH TASK IN STRATUM i OF A PERMUTATION OF THE REPLICATE
+	SamplingMode Sampling;
+
+	//LARGEST SHIFT OF THE NORMAL OF A LONGEST STEP UNDER IMPORTANCE SAMPLING (SEE GetImportanceShifts), 0 WITHOUT IT
+	double ImportanceShift;
+
+	//FOLDER OF THE SampleCache FILES, EMPTY TO DRAW THE TIMES OF EVERY JOB AGAIN
+	std::string SampleCacheFolder;
+
+	//FRAMES DRAWN AHEAD OF THE SIMULATION WHEN STREAMING, 0 TO DRAW ALL THE FRAMES BEFORE IT
+	int StreamFrames;
+
+	//ADD THE LOWER BOUNDS OF EACH FRAME AND THE RATIO OF ITS DURATION TO THE BEST ONE TO THE RESULT FILES
+	bool BoundsOutput;
+
+	//WRITE THE WARM-UP AND STEADY STATE OF EACH LAG REGIME. WITH A WIDTH, STOP ONCE THE 95% INTERVAL OF THE
+	//STEADY MEAN FRAME OF EVERY REGIME IS NARROWER THAN THE WIDTH TIMES THE MEAN, AND ESTIMATE THE FRAMES LEFT
+	bool SteadyStateOutput;
+	double SteadyStateWidth;
+
+	//SEEDS PER ROUND OF THE RACE BETWEEN THE METHODS, 0 TO RUN EVERY METHOD ON EVERY SEED
+	int RacingSeeds;
+
+	//WIDTHS OF THE 95% CONFIDENCE INTERVALS OF THE MEAN FRAME DURATION AND OF THE NUMBER OF DELAYED
+	//FRAMES BELOW WHICH NO MORE SEEDS ARE RUN FOR A CONFIGURATION, 0 TO RUN ALL THE SEEDS
+	double AdaptiveFrameWidth;
+	double AdaptiveDelayedWidth;
+
+	//EVERY JOB WORKS ON ITS OWN COPY OF ALL THE PARAMETERS: THE TASKS OF m_sequence ARE SHARED
+	SimulationParameters() = default;
+	SimulationParameters(const SimulationParameters& _parameters) = default;
+	SimulationParameters& operator=(const SimulationParameters& _parameters) = default;
 };
 
+class FrameStream;
+
 class Simulation
 {
 public:
-    static void Play(SimulationParameters& _parameters, std::string Strategy);
-	static void SLACK(SimulationParameters& _parameters, std::pair<int, Task*> key);
+    // _nbThreads: threads drawing the streamed frames. Returns the metrics of the frames played
+    static FrameMetrics Play(SimulationParameters& _parameters, std::string Strategy, int _nbThreads = 1);
+	static void DumpTotalExecution(SimulationParameters& _parameters, int _nbThreads = 1);
+
+	//RESULT FILE OF A SIMULATION: Result/Strategy/nbWorkers/nbFrame/_folder/reportName_extension
+	static std::string GetResultFile(const SimulationParameters& _parameters, const std::string& Strategy, const std::string& _folder, const std::string& _extension);
+
+	//GIVE THE TASKS THE TIMES OF FRAME _frame, AND THE PROCESSING TIMES OF THE FRAME BEFORE
+	static void BindFrame(SimulationParameters& _parameters, const FrameStream& _frames, SequenceState& _state, int _frame);
+
+	//LIKELIHOOD RATIO OF THE DURATION OF FRAME _frame UNDER IMPORTANCE SAMPLING, WITH A STRATEGY READING THE TIMES
+	//OF THE _historyFrames FRAMES BEFORE (StrategyInfo::m_historyFrames)
+	static double GetFrameWeight(const FrameStream& _frames, int _frame, int _historyFrames);
 	
 private:
 	
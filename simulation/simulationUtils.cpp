@@ -1,9 +1,14 @@
 #include <stdafx.h>
 #include <assert.h>
+#include <cmath>
 #include <fstream>
 #include <map>
 #include <string>
 #include "simulationUtils.h"
+#include "counterRng.h"
+#include "lognormalSampler.h"
+#include "lagGenerator.h"
+#include "statistics.h"
 #include "tasks/keytasks.h"
 
 using namespace std;
@@ -148,85 +153,214 @@ void SimulationUtils::AddSons(SimulationParameters& _parameters)
 
 void SimulationUtils::GenerateLagProportion(SimulationParameters& _parameters)
 {
-	bool simulationLagStatus = false;
-	double maxLagFrame = 200;
-	double countLagFrame = 1;
-	double lagProportion = 0;
-	std::map<int, double> lags;
+	// Streamed frames draw their lags while the simulation runs
+	if (_parameters.StreamFrames > 0)
+	{
+		_parameters.m_lags.clear();
+		return;
+	}
+	LagGenerator generator(_parameters.CounterRng);
+	std::vector<double> lags(_parameters.m_iNbFrames);
 	for (int i = 0; i < _parameters.m_iNbFrames; i++)
 	{
-
-		if (simulationLagStatus == false) {
-			countLagFrame = 1;
-			lags[i] = lagProportion;
-			simulationLagStatus = ((std::rand() % 2000) > 200);
-		}
-
-		else {
-			if (countLagFrame < (maxLagFrame / 2))
-				lagProportion = 2 * countLagFrame / maxLagFrame;
-
-			else
-				lagProportion = 2 * (1 - countLagFrame / maxLagFrame);
-
-			lags[i] = lagProportion;
-			countLagFrame++;
-			simulationLagStatus = (countLagFrame != maxLagFrame);
-		}
-
+		lags[i] = generator.Next();
 	}
 	_parameters.m_lags = lags;
 }
-void SimulationUtils::ExecutionTimeControl(SimulationParameters& _parameters)
+void SimulationUtils::ExecutionTimeControl(SimulationParameters& _parameters, int _nbThreads)
 {
-	std::map<std::string, Task*> Map = _parameters.m_sequence.GetTaskMap();
-	std::map<std::pair<int, Task*>, vector<double>> Times;
-	for (int i = 0;i < _parameters.m_lags.size();i++)
+	const std::vector<Task*>& tasks = _parameters.m_sequence.GetTasks();
+	SampleStore& Times = _parameters.m_times;
+	int nbFrames = _parameters.m_lags.size();
+	Times.Clear(nbFrames, tasks.size());
+	// All the slices are added first: each one is then filled on its own, frames in parallel
+	for (int i = 0;i < nbFrames;i++)
 	{
-		for (auto elem : Map)
+		for (Task* task : tasks)
 		{
-			std::pair<double, Task* > key = std::make_pair(i, elem.second);
-			int steps = elem.second->GetStep(_parameters.m_lags[i]);
-
-			std::vector<double> distributionParameters = elem.second->GenerateTime(_parameters.m_lags[i]);
-			std::lognormal_distribution<double> distribution(distributionParameters[0], distributionParameters[1]);
-			std::minstd_rand0 generator = elem.second->GetGenerator(elem.second->GetTopoOrder()*_parameters.m_seed* _parameters.m_iNbFrames +i);
-			for (int j = 0;j < steps;j++)
-			{
-				double execution_time = std::min(distribution(generator), distributionParameters[2]);
-				execution_time = std::max(execution_time, distributionParameters[3]);
-				if (_parameters.IsDivided)
-				{
-					if(elem.first==P_TASK||elem.first==P2_TASK)
-					{
-						Times[key].push_back(execution_time/2.0);
-						Times[key].push_back(execution_time/2.0);
-					}
-					else{
-						Times[key].push_back(execution_time);
-					}
+			Times.AddSlice(GetSampleCount(_parameters, task, _parameters.m_lags[i]));
+		}
+	}
+	ForEachFrame(nbFrames, _nbThreads, [&](int _frame)
+	{
+		std::vector<double> shifts = GetImportanceShifts(_parameters, _parameters.m_lags[_frame]);
+		double logWeight = 0.0;
+		for (Task* task : tasks)
+		{
+			logWeight += SampleTimes(_parameters, _frame, _parameters.m_lags[_frame], task, shifts[task->GetIndex()], Times.GetSlice(_frame, task->GetIndex()));
+		}
+		Times.SetLogWeight(_frame, logWeight);
+	});
+	Times.ComputeTotals(_parameters.m_sequence.GetIndicesByName());
+}
 
-				}
-				else
-				{
-					Times[key].push_back(execution_time);
-				}
+void SimulationUtils::ForEachFrame(int _nbFrames, int _nbThreads, const std::function<void(int)>& _function)
+{
+	std::atomic<int> nextFrame(0);
+	auto run = [&]()
+	{
+		for (int i = nextFrame++; i < _nbFrames; i = nextFrame++)
+		{
+			_function(i);
+		}
+	};
+	int nbThreads = std::max(1, std::min(_nbThreads, _nbFrames));
+	std::vector<std::thread> threads;
+	for (int t = 1; t < nbThreads; t++)
+	{
+		threads.push_back(std::thread(run));
+	}
+	run();
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+}
 
+int SimulationUtils::GetSampleCount(const SimulationParameters& _parameters, const Task* _task, double _lag)
+{
+	int steps = _task->GetStep(_lag);
+	bool divided = _parameters.IsDivided && (_task->GetName() == P_TASK || _task->GetName() == P2_TASK);
+	return divided ? 2 * steps : steps;
+}
 
+// The duration of a frame is set by the longest steps of the tasks of its critical path. Under importance
+// sampling, the tasks of the critical path of the frame with each task at its median (its median longest
+// step for an engine task, its median step times its steps for a graphic one) get a shift: ImportanceShift
+// times the spread of their longest step (quantile 0.9 minus median) over the largest spread of the path.
+std::vector<double> SimulationUtils::GetImportanceShifts(const SimulationParameters& _parameters, double _lag)
+{
+	const std::vector<Task*>& tasks = _parameters.m_sequence.GetTasks();
+	std::vector<double> shifts(tasks.size(), 0.0);
+	if (_parameters.ImportanceShift == 0.0)
+	{
+		return shifts;
+	}
+	std::vector<const Task*> fathersFirst;
+	std::vector<int> remainingFathers(tasks.size());
+	std::vector<double> duration(tasks.size(), 0.0);
+	std::vector<double> spread(tasks.size(), 0.0);
+	for (Task* task : tasks)
+	{
+		remainingFathers[task->GetIndex()] = task->GetFathers().size();
+		if (task->GetFathers().empty())
+		{
+			fathersFirst.push_back(task);
+		}
+		int steps = task->GetStep(_lag);
+		if (steps > 0)
+		{
+			TimeDistribution distribution = task->GenerateTime(_lag);
+			double median = LognormalSampler::LongestQuantile(distribution, steps, 0.5);
+			spread[task->GetIndex()] = LognormalSampler::LongestQuantile(distribution, steps, 0.9) - median;
+			duration[task->GetIndex()] = (task->GetTaskType() == TaskType::GRAPHIC) ? steps * LognormalSampler::LongestQuantile(distribution, 1, 0.5) : median;
+		}
+	}
+	for (size_t i = 0; i < fathersFirst.size(); i++)
+	{
+		for (Task* son : fathersFirst[i]->GetSons())
+		{
+			if (--remainingFathers[son->GetIndex()] == 0)
+			{
+				fathersFirst.push_back(son);
 			}
-			if(_parameters.SortingSteps)
-				std::sort(Times[key].begin(), Times[key].end(), greater<double>());
-
 		}
 	}
 
-	_parameters.m_times = Times;
+	// Longest paths to the start and from the end of each task
+	std::vector<double> pathStart(tasks.size(), 0.0);
+	std::vector<double> pathEnd(tasks.size(), 0.0);
+	double criticalPath = 0.0;
+	for (const Task* task : fathersFirst)
+	{
+		for (Task* father : task->GetFathers())
+		{
+			pathStart[task->GetIndex()] = std::max(pathStart[task->GetIndex()], pathStart[father->GetIndex()] + duration[father->GetIndex()]);
+		}
+	}
+	for (auto task = fathersFirst.rbegin(); task != fathersFirst.rend(); task++)
+	{
+		for (Task* son : (*task)->GetSons())
+		{
+			pathEnd[(*task)->GetIndex()] = std::max(pathEnd[(*task)->GetIndex()], pathEnd[son->GetIndex()] + duration[son->GetIndex()]);
+		}
+		criticalPath = std::max(criticalPath, pathStart[(*task)->GetIndex()] + duration[(*task)->GetIndex()] + pathEnd[(*task)->GetIndex()]);
+	}
+	std::vector<const Task*> path;
+	double largestSpread = 0.0;
+	for (Task* task : tasks)
+	{
+		int index = task->GetIndex();
+		if (pathStart[index] + duration[index] + pathEnd[index] >= criticalPath * (1.0 - 1e-9))
+		{
+			path.push_back(task);
+			largestSpread = std::max(largestSpread, spread[index]);
+		}
+	}
+	for (const Task* task : path)
+	{
+		shifts[task->GetIndex()] = (largestSpread > 0.0) ? _parameters.ImportanceShift * spread[task->GetIndex()] / largestSpread : 0.0;
+	}
+	return shifts;
+}
 
-	//////Assign choice for tasks time: Randome or Median.
-	for (auto elem : Map)
+double SimulationUtils::SampleTimes(const SimulationParameters& _parameters, int _frame, double _lag, const Task* _task, double _shift, double* _times)
+{
+	int steps = _task->GetStep(_lag);
+	bool divided = _parameters.IsDivided && (_task->GetName() == P_TASK || _task->GetName() == P2_TASK);
+
+	TimeDistribution distribution = _task->GenerateTime(_lag);
+	int seedIndex = _parameters.m_seed - _parameters.m_startSeed;
+	double logWeight = 0.0;
+	// The frame durations depend on the longest steps far more than on the others:
+	// the two modes only pair or stratify the longest step of each task
+	if (_parameters.CounterRng && _parameters.Sampling == SamplingMode::ANTITHETIC)
+	{
+		CounterRng pair(_parameters.m_startSeed + (seedIndex & ~1));
+		bool second = (seedIndex & 1) != 0;
+		double longest = LognormalSampler::LongestUniform(pair, _task->GetIndex(), _frame);
+		LognormalSampler::SampleLongest(distribution, pair, second ? 1.0 - longest : longest, second, _task->GetIndex(), _frame, steps, _times);
+	}
+	else if (_parameters.CounterRng && _parameters.Sampling == SamplingMode::LATIN_HYPERCUBE)
+	{
+		int point = seedIndex % LATIN_HYPERCUBE_SEEDS;
+		CounterRng rng(_parameters.m_seed);
+		double longest = LognormalSampler::LatinHypercubeLongest(CounterRng(_parameters.m_seed - point), rng, point, _task->GetIndex(), _frame);
+		LognormalSampler::SampleLongest(distribution, rng, longest, false, _task->GetIndex(), _frame, steps, _times);
+	}
+	else if (_shift != 0.0)
+	{
+		// The normal z of the longest step is drawn plus _shift: phi(z + _shift) / phi(z) = exp(-_shift * z - _shift^2 / 2).
+		// Its quantile is kept below 1, as the uniform numbers
+		CounterRng rng(_parameters.m_seed);
+		double normal = Statistics::NormalQuantile(LognormalSampler::LongestUniform(rng, _task->GetIndex(), _frame));
+		double longest = std::min(Statistics::NormalCdf(normal + _shift), 1.0 - 1e-16);
+		LognormalSampler::SampleLongest(distribution, rng, longest, false, _task->GetIndex(), _frame, steps, _times);
+		logWeight = -_shift * normal - 0.5 * _shift * _shift;
+	}
+	else if (_parameters.CounterRng)
+	{
+		LognormalSampler::SampleCounter(distribution, CounterRng(_parameters.m_seed), _task->GetIndex(), _frame, steps, _times);
+	}
+	else
 	{
-		elem.second->WichToAssign(_parameters.mode);
+		std::minstd_rand0 generator = _task->GetGenerator(_task->GetTopoOrder()*_parameters.m_seed* _parameters.m_iNbFrames +_frame);
+		LognormalSampler::SampleLegacy(distribution, generator, steps, _times);
+	}
+	int count = steps;
+	if (divided)
+	{
+		// Each step is split in two halves, in place from the last step
+		for (int j = steps - 1; j >= 0; j--)
+		{
+			_times[2 * j + 1] = _times[j] / 2.0;
+			_times[2 * j] = _times[j] / 2.0;
+		}
+		count = 2 * steps;
 	}
+	if(_parameters.SortingSteps)
+		std::sort(_times, _times + count, greater<double>());
+	return logWeight;
 }
 
 
@@ -22,7 +22,16 @@ public:
 	static bool permetted(Task* _task, std::vector<Task*> _setTask);
 	static void AddSons(SimulationParameters& _parameters);
 	static void GenerateLagProportion(SimulationParameters& _parameters);
-	static void ExecutionTimeControl(SimulationParameters& _parameters);
+	//DRAW THE EXECUTION TIMES OF EVERY FRAME, USING UP TO _nbThreads THREADS
+	static void ExecutionTimeControl(SimulationParameters& _parameters, int _nbThreads = 1);
+	//NUMBER OF TIMES OF A TASK IN A FRAME WITH LAG _lag, AND THE TIMES OF FRAME _frame
+	static int GetSampleCount(const SimulationParameters& _parameters, const Task* _task, double _lag);
+	//SHIFTS OF THE NORMAL OF THE LONGEST STEP OF EACH TASK UNDER IMPORTANCE SAMPLING IN A FRAME WITH LAG _lag, BY TASK INDEX
+	static std::vector<double> GetImportanceShifts(const SimulationParameters& _parameters, double _lag);
+	//RETURNS THE LOG OF THE LIKELIHOOD RATIO OF THE TIMES DRAWN WITH THE SHIFT _shift, 0 WITHOUT IT
+	static double SampleTimes(const SimulationParameters& _parameters, int _frame, double _lag, const Task* _task, double _shift, double* _times);
+	//CALL _function ON FRAMES 0 TO _nbFrames-1, USING UP TO _nbThreads THREADS
+	static void ForEachFrame(int _nbFrames, int _nbThreads, const std::function<void(int)>& _function);
 	static void TopologicalSorting(SimulationParameters& _parameters);
 	static void LexicographicalSorting(SimulationParameters& _parameters);
 	static void HU(SimulationParameters& _parameters);
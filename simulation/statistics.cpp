@@ -0,0 +1,132 @@
+#include <stdafx.h>
+#include <cmath>
+
+#include "statistics.h"
+
+namespace
+{
+	// Continued fraction of the regularized incomplete beta function I_x(a, b), by the modified Lentz method,
+	// converging quickly for x < (a + 1) / (a + b + 2)
+	double BetaFraction(double _a, double _b, double _x)
+	{
+		const double tiny = 1e-300;
+		double c = 1.0;
+		double d = 1.0 - (_a + _b) * _x / (_a + 1.0);
+		d = 1.0 / ((std::fabs(d) < tiny) ? tiny : d);
+		double result = d;
+		for (int m = 1; m <= 300; m++)
+		{
+			for (int odd = 0; odd < 2; odd++)
+			{
+				double term = (odd == 0) ? m * (_b - m) * _x / ((_a + 2 * m - 1.0) * (_a + 2 * m))
+					: -(_a + m) * (_a + _b + m) * _x / ((_a + 2 * m) * (_a + 2 * m + 1.0));
+				d = 1.0 + term * d;
+				d = 1.0 / ((std::fabs(d) < tiny) ? tiny : d);
+				c = 1.0 + term / c;
+				c = (std::fabs(c) < tiny) ? tiny : c;
+				result *= c * d;
+				if (odd == 1 && std::fabs(c * d - 1.0) < 1e-15)
+				{
+					return result;
+				}
+			}
+		}
+		return result;
+	}
+
+	double RegularizedBeta(double _a, double _b, double _x)
+	{
+		if (_x <= 0.0 || _x >= 1.0)
+		{
+			return (_x <= 0.0) ? 0.0 : 1.0;
+		}
+		double front = std::exp(std::lgamma(_a + _b) - std::lgamma(_a) - std::lgamma(_b) + _a * std::log(_x) + _b * std::log(1.0 - _x));
+		if (_x < (_a + 1.0) / (_a + _b + 2.0))
+		{
+			return front * BetaFraction(_a, _b, _x) / _a;
+		}
+		return 1.0 - front * BetaFraction(_b, _a, 1.0 - _x) / _b;
+	}
+}
+
+double Statistics::Mean(const std::vector<double>& _values)
+{
+	double sum = 0.0;
+	for (double value : _values)
+	{
+		sum += value;
+	}
+	return _values.empty() ? 0.0 : sum / _values.size();
+}
+
+double Statistics::Variance(const std::vector<double>& _values)
+{
+	if (_values.size() < 2)
+	{
+		return 0.0;
+	}
+	double mean = Mean(_values);
+	double sum = 0.0;
+	for (double value : _values)
+	{
+		sum += (value - mean) * (value - mean);
+	}
+	return sum / (_values.size() - 1);
+}
+
+// Rational approximation of P. J. Acklam, relative error below 1.15e-9
+double Statistics::NormalQuantile(double _p)
+{
+	static const double a[6] = { -3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02, 1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00 };
+	static const double b[5] = { -5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02, 6.680131188771972e+01, -1.328068155288572e+01 };
+	static const double c[6] = { -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00, -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00 };
+	static const double d[4] = { 7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00, 3.754408661907416e+00 };
+	const double pLow = 0.02425;
+
+	if (_p < pLow || _p > 1.0 - pLow)
+	{
+		double q = std::sqrt(-2.0 * std::log(std::min(_p, 1.0 - _p)));
+		double x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+		return (_p < pLow) ? x : -x;
+	}
+	double q = _p - 0.5;
+	double r = q * q;
+	return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q / (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+}
+
+// Exact for 1 and 2 degrees of freedom, Cornish-Fisher expansion around the normal quantile above
+double Statistics::StudentQuantile(double _p, int _df)
+{
+	if (_df == 1)
+	{
+		return std::tan(M_PI * (_p - 0.5));
+	}
+	if (_df == 2)
+	{
+		return (2.0 * _p - 1.0) / std::sqrt(2.0 * _p * (1.0 - _p));
+	}
+	double z = NormalQuantile(_p);
+	double z2 = z * z;
+	double n = _df;
+	double g1 = z * (z2 + 1.0) / 4.0;
+	double g2 = z * ((5.0 * z2 + 16.0) * z2 + 3.0) / 96.0;
+	double g3 = z * (((3.0 * z2 + 19.0) * z2 + 17.0) * z2 - 15.0) / 384.0;
+	double g4 = z * ((((79.0 * z2 + 776.0) * z2 + 1482.0) * z2 - 1920.0) * z2 - 945.0) / 92160.0;
+	return z + g1 / n + g2 / (n * n) + g3 / (n * n * n) + g4 / (n * n * n * n);
+}
+
+double Statistics::NormalCdf(double _x)
+{
+	return 0.5 * std::erfc(-_x / std::sqrt(2.0));
+}
+
+// P(T > t) = I_x(df/2, 1/2) / 2 with x = df / (df + t^2), for t >= 0
+double Statistics::StudentUpperTail(double _t, int _df)
+{
+	if (std::isinf(_t))
+	{
+		return (_t > 0.0) ? 0.0 : 1.0;
+	}
+	double tail = 0.5 * RegularizedBeta(_df / 2.0, 0.5, _df / (_df + _t * _t));
+	return (_t >= 0.0) ? tail : 1.0 - tail;
+}
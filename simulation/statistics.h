@@ -0,0 +1,20 @@
+#pragma once
+
+#include <vector>
+
+// Sample statistics used to compare the simulated configurations over their seeds
+class Statistics
+{
+public:
+	static double Mean(const std::vector<double>& _values);
+	//UNBIASED SAMPLE VARIANCE, 0 WITH LESS THAN TWO VALUES
+	static double Variance(const std::vector<double>& _values);
+
+	//QUANTILE _p OF THE STANDARD NORMAL AND OF THE STUDENT T DISTRIBUTION WITH _df DEGREES OF FREEDOM
+	static double NormalQuantile(double _p);
+	static double StudentQuantile(double _p, int _df);
+	//PROBABILITY THAT A STANDARD NORMAL VARIABLE IS BELOW _x
+	static double NormalCdf(double _x);
+	//PROBABILITY THAT A STUDENT T VARIABLE WITH _df DEGREES OF FREEDOM IS ABOVE _t: THE P-VALUE OF A ONE-SIDED TEST
+	static double StudentUpperTail(double _t, int _df);
+};
@@ -0,0 +1,151 @@
+#include <stdafx.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include "steadyState.h"
+#include "lagGenerator.h"
+#include "statistics.h"
+
+namespace
+{
+	const int BATCH = 5;
+	// Batches kept after the warm-up before the interval of the mean is trusted
+	const int MIN_STEADY_BATCHES = 4;
+	// Frames between two checks of the stopping rule, at least: the checks get sparser as the frames add up
+	const int CHECK_PERIOD = 25;
+}
+
+// Streamed frames draw their lags with the counter-based generator, from the first frame
+SteadyState::SteadyState(const SimulationParameters& _parameters)
+{
+	m_width = _parameters.SteadyStateWidth;
+	m_nbPlayed = 0;
+	m_nextCheck = CHECK_PERIOD;
+	LagGenerator generator(true);
+	for (int i = 0; i < _parameters.m_iNbFrames; i++)
+	{
+		double lag = (_parameters.StreamFrames > 0) ? generator.Next() : _parameters.m_lags[i];
+		m_regimes[GetRegime(lag)].m_nbScheduled++;
+	}
+}
+
+int SteadyState::GetRegime(double _lag)
+{
+	if (_lag <= 0.0)
+	{
+		return 0;
+	}
+	return 1 + std::min(NB_LAG_LEVELS - 1, (int)std::ceil(_lag * NB_LAG_LEVELS) - 1);
+}
+
+bool SteadyState::Add(double _lag, double _duration, double _weight)
+{
+	Regime& regime = m_regimes[GetRegime(_lag)];
+	regime.m_durations.push_back(_duration);
+	regime.m_weights.push_back(_weight);
+	m_nbPlayed++;
+	if (m_width <= 0.0 || m_nbPlayed < m_nextCheck)
+	{
+		return false;
+	}
+	m_nextCheck = std::max(m_nbPlayed + CHECK_PERIOD, (int)(m_nbPlayed * 1.05));
+	for (const Regime& other : m_regimes)
+	{
+		if (!IsSettled(other))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Truncation d of the k batch means b minimizing sum over j >= d of (b_j - mean)^2 / (k - d)^2, with d <= k/2
+int SteadyState::GetWarmUp(const Regime& _regime)
+{
+	int nbBatches = _regime.m_durations.size() / BATCH;
+	std::vector<double> batches(nbBatches, 0.0);
+	for (int i = 0; i < nbBatches * BATCH; i++)
+	{
+		batches[i / BATCH] += _regime.m_durations[i] / BATCH;
+	}
+	int best = 0;
+	double bestValue = INFINITY;
+	double sum = 0.0;
+	double squares = 0.0;
+	for (int d = nbBatches - 1; d >= 0; d--)
+	{
+		sum += batches[d];
+		squares += batches[d] * batches[d];
+		int kept = nbBatches - d;
+		double value = std::max(0.0, squares - sum * sum / kept) / ((double)kept * kept);
+		if (kept > 1 && 2 * d <= nbBatches && value <= bestValue)
+		{
+			best = d;
+			bestValue = value;
+		}
+	}
+	return best * BATCH;
+}
+
+bool SteadyState::IsSettled(const Regime& _regime) const
+{
+	int nbPlayed = _regime.m_durations.size();
+	if (nbPlayed >= _regime.m_nbScheduled)
+	{
+		return true;
+	}
+	int warmUp = GetWarmUp(_regime);
+	std::vector<double> batches((nbPlayed - warmUp) / BATCH, 0.0);
+	if ((int)batches.size() < MIN_STEADY_BATCHES)
+	{
+		return false;
+	}
+	for (size_t i = 0; i < batches.size() * BATCH; i++)
+	{
+		batches[i / BATCH] += _regime.m_durations[warmUp + i] / BATCH;
+	}
+	double halfWidth = Statistics::StudentQuantile(0.975, batches.size() - 1) * std::sqrt(Statistics::Variance(batches) / batches.size());
+	return halfWidth <= m_width * Statistics::Mean(batches);
+}
+
+FrameMetrics SteadyState::GetMetrics(const Regime& _regime, int _first, int _last)
+{
+	FrameMetrics metrics;
+	for (int i = _first; i < _last; i++)
+	{
+		metrics.Add(_regime.m_durations[i], _regime.m_weights[i]);
+	}
+	return metrics;
+}
+
+FrameMetrics SteadyState::Estimate(const FrameMetrics& _played) const
+{
+	FrameMetrics metrics = _played;
+	for (const Regime& regime : m_regimes)
+	{
+		int nbLeft = regime.m_nbScheduled - (int)regime.m_durations.size();
+		if (nbLeft > 0 && !regime.m_durations.empty())
+		{
+			metrics.AddEstimate(nbLeft, GetMetrics(regime, GetWarmUp(regime), regime.m_durations.size()));
+		}
+	}
+	return metrics;
+}
+
+void SteadyState::Write(const std::string& _fileName) const
+{
+	std::ofstream file(_fileName);
+	for (int i = 0; i < NB_REGIMES; i++)
+	{
+		const Regime& regime = m_regimes[i];
+		int nbPlayed = regime.m_durations.size();
+		int warmUp = GetWarmUp(regime);
+		FrameMetrics warmUpMetrics = GetMetrics(regime, 0, warmUp);
+		FrameMetrics steadyMetrics = GetMetrics(regime, warmUp, nbPlayed);
+		double nbSteady = std::max(1, steadyMetrics.m_nbFrames);
+		file << i << " " << regime.m_nbScheduled << " " << nbPlayed << " " << warmUp
+			<< " " << warmUpMetrics.GetMeanFrame() << " " << warmUpMetrics.m_delayedFrames
+			<< " " << steadyMetrics.GetMeanFrame() << " " << steadyMetrics.m_delayedFrames / nbSteady << " " << steadyMetrics.m_cumulativeSlowdown / nbSteady << std::endl;
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "simulation.h"
+#include "frameMetrics.h"
+
+// Steady state of the frame durations of a simulation, for each lag regime: no lag, or a lag in
+// one of NB_LAG_LEVELS equal ranges of ]0, 1]. The first frames of a regime are a warm-up (the
+// history-based strategies have no processing times of a previous frame yet), detected with the
+// MSER-5 rule: the batches of 5 frames dropped are those that minimize the standard error of the
+// mean of the batches kept.
+// With a width, the simulation can stop once the mean duration of every regime with frames left in
+// the schedule is known within it: the frames left count for the steady-state rates of their regime.
+class SteadyState
+{
+public:
+	static const int NB_LAG_LEVELS = 20;
+	static const int NB_REGIMES = NB_LAG_LEVELS + 1;
+
+	//THE LAGS OF ALL THE FRAMES OF THE SIMULATION GIVE THE NUMBER OF FRAMES OF EACH REGIME
+	SteadyState(const SimulationParameters& _parameters);
+
+	static int GetRegime(double _lag);
+
+	//ADD THE NEXT FRAME PLAYED; TRUE WHEN THE FRAMES LEFT CAN BE ESTIMATED INSTEAD OF PLAYED
+	bool Add(double _lag, double _duration, double _weight);
+
+	//METRICS OF ALL THE FRAMES OF THE SCHEDULE: _played, AND THE FRAMES LEFT AT THE STEADY-STATE RATES OF THEIR REGIME
+	FrameMetrics Estimate(const FrameMetrics& _played) const;
+
+	//ONE LINE PER REGIME: REGIME, FRAMES SCHEDULED, FRAMES PLAYED, WARM-UP FRAMES, THEIR MEAN AND DF,
+	//THEN THE MEAN, DF AND CS PER STEADY FRAME
+	void Write(const std::string& _fileName) const;
+
+private:
+	struct Regime
+	{
+		int m_nbScheduled = 0;
+		std::vector<double> m_durations;
+		std::vector<double> m_weights;
+	};
+
+	//FRAMES OF THE WARM-UP OF A REGIME, A MULTIPLE OF THE BATCH SIZE
+	static int GetWarmUp(const Regime& _regime);
+	//TRUE WHEN ALL THE FRAMES OF THE REGIME ARE PLAYED OR ITS STEADY MEAN IS KNOWN WITHIN m_width
+	bool IsSettled(const Regime& _regime) const;
+	//METRICS OF FRAMES _first TO _last-1 OF A REGIME
+	static FrameMetrics GetMetrics(const Regime& _regime, int _first, int _last);
+
+	double m_width;
+	int m_nbPlayed;
+	int m_nextCheck;
+	Regime m_regimes[NB_REGIMES];
+};
@@ -0,0 +1,35 @@
+#include <stdafx.h>
+#include "sequenceState.h"
+
+SequenceState::SequenceState(TaskSequence& _sequence)
+{
+    m_sequence = &_sequence;
+    std::map<std::string, Task*>& taskMap = _sequence.GetTaskMap();
+    m_states.assign(taskMap.size(), TaskState(nullptr));
+    for (auto elem : taskMap)
+    {
+        m_states[elem.second->GetIndex()] = TaskState(elem.second);
+    }
+}
+
+void SequenceState::Reset()
+{
+    for (TaskState& state : m_states)
+    {
+        state.Reset();
+    }
+}
+
+TaskState* SequenceState::GetState(std::string _taskName)
+{
+    Task* task = m_sequence->GetTask(_taskName);
+    return (task != nullptr) ? GetState(task) : nullptr;
+}
+
+void SequenceState::WichToAssign(std::string _choice)
+{
+    for (TaskState& state : m_states)
+    {
+        state.WichToAssign(_choice);
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "taskSequence.h"
+#include "taskState.h"
+
+// State of all the tasks of a sequence during one simulation.
+// The sequence itself is only read, so several states (parallel runs, ACO ants) can share it.
+class SequenceState
+{
+
+public:
+    SequenceState(TaskSequence& _sequence);
+
+    //BACK TO THE STATE BEFORE THE FIRST FRAME
+    void Reset();
+
+    TaskSequence& GetSequence() { return *m_sequence; };
+    TaskState* GetState(const Task* _task) { return &m_states[_task->GetIndex()]; };
+    TaskState* GetState(std::string _taskName);
+
+    //ADD MODE TO WORK WORK: RANDOM OR MEDIAN
+    void WichToAssign(std::string _choice);
+
+private:
+    TaskSequence* m_sequence;
+    std::vector<TaskState> m_states;
+};
@@ -16,73 +16,23 @@ Task::Task(std::string _name, int _steps, double _mean, double _min, double _max
 	m_minLag = _minLag;
 	m_maxLag = _maxLag;
 	m_stdDevLag = _stdDevLag;
-	m_type = _type;
-	
-	
-}
-
-void Task::Initialize(double _lagProportion)
-{
-	m_iCurrentStep = 0;
-	
-	m_totalSteps = this->GetStepCount();
-	
-	if (m_choice == "Random")
-	{
-	
-		m_remainingTimes = this->GetTime();
-	}
-	if (m_choice == "Median")
-	{
-		AssignMediane(_lagProportion);
-	}
-	
-}
-
-void Task::AssignRandomTimes(double _lagProportion)
-{
-	m_meanTime = 0.0;
-	m_remainingTimes.clear();
-	double k = 0;
-	m_graphicTime = 0.0;
-	for (int i = 0; i < m_totalSteps; i++)
-	{
-		
-		m_remainingTimes.push_back(k);
-		
-		m_meanTime += k;
-	}
-	
-}
-
-void Task::PushInTime(std::vector<double> _Times)
-{ 
-	m_Times = _Times; 
-};
+	m_type = (_type == "engine") ? TaskType::ENGINE : TaskType::GRAPHIC;
 
-
-void Task::AssignMediane(double _lagProportion)
-{
-	m_meanTime = 0.0;
-	m_remainingTimes.clear();
-	double k = 0;
-	m_graphicTime = 0.0;
-	for (int i = 0; i < m_totalSteps; i++)
-	{
-		k =(1 - _lagProportion) * m_mean + _lagProportion * m_meanLag;;
-		m_remainingTimes.push_back(k);
-		
-		m_meanTime += k;
-	}
+	m_index = -1;
+	m_level = 0;
+	m_label = 0;
+	m_TopoOrder = 0;
+	m_Wl = 0.0;
+	m_Hu = 0.0;
 }
 
-std::minstd_rand0 Task::GetGenerator(double seed)
+std::minstd_rand0 Task::GetGenerator(double seed) const
 { 
-	
-	m_generator.seed(seed);
-	return m_generator; 
+	std::minstd_rand0 generator;
+	generator.seed(seed);
+	return generator; 
 };
-std::vector<double> Task::GenerateTime(double _lagProportion)
+TimeDistribution Task::GenerateTime(double _lagProportion) const
 {
 	
 	double meanWithLag = (1 - _lagProportion) * m_mean + _lagProportion * m_meanLag;
@@ -93,38 +43,16 @@ std::vector<double> Task::GenerateTime(double _lagProportion)
 
 	double meanLog = log((meanWithLag * meanWithLag) / sqrt(meanWithLag * meanWithLag + stdDevWithLag * stdDevWithLag));
 	double stdDevLog = sqrt(log(1 + (stdDevWithLag * stdDevWithLag) / (meanWithLag * meanWithLag)));
-	std::vector<double> ret(0);
-	ret.push_back(meanLog);
-	ret.push_back(stdDevLog);
-	ret.push_back(maxWithLag);
-	ret.push_back(minWithLag);
-	return ret;
-}
-
-void Task::UpdateStepCount(int _nb)
-{ 
-	m_totalSteps = _nb; 
+	return { meanLog, stdDevLog, maxWithLag, minWithLag };
 }
 
-double Task::GenerateTimeSeed(double _lagProportion, std::minstd_rand0 generator)
+double Task::GenerateTimeSeed(double _lagProportion, std::minstd_rand0 generator) const
 {
-	//m_generator.seed(this->GetTopoOrder);
-	double meanWithLag = (1 - _lagProportion) * m_mean + _lagProportion * m_meanLag;
-
-	double stdDevWithLag = (1 - _lagProportion) * m_stdDev + _lagProportion * m_stdDevLag;
-	double maxWithLag = (1 - _lagProportion) * m_max + _lagProportion * m_maxLag;
-	double minWithLag = (1 - _lagProportion) * m_min + _lagProportion * m_minLag;
-
-	double meanLog = log((meanWithLag * meanWithLag) / sqrt(meanWithLag * meanWithLag + stdDevWithLag * stdDevWithLag));
-	double stdDevLog = sqrt(log(1 + (stdDevWithLag * stdDevWithLag) / (meanWithLag * meanWithLag)));
-
-
-	std::lognormal_distribution<double> distribution(meanLog, stdDevLog);
+	TimeDistribution distribution = GenerateTime(_lagProportion);
+	std::lognormal_distribution<double> lognormal(distribution.m_meanLog, distribution.m_stdDevLog);
 
-
-	double execution_time = std::min(distribution(generator), maxWithLag);
-	execution_time = std::max(execution_time, minWithLag);
-	m_meanLog = meanLog;
+	double execution_time = std::min(lognormal(generator), distribution.m_max);
+	execution_time = std::max(execution_time, distribution.m_min);
 	return execution_time;
 }
 
@@ -139,103 +67,7 @@ void Task::AddSon(Task* _son)
 	m_sons.push_back(_son);
 }
 
-void Task::Execute(int _step)
-{
-	SpendTime(_step, GetRemainingTimeForStep(_step));
-}
-
-void Task::SpendTime(int _step, double _time)
-{
-	if (_step < m_remainingTimes.size())
-	{
-		m_remainingTimes[_step] = std::max(0.0, m_remainingTimes[_step] - _time);
-	}
-}
-
-double Task::GetRemainingTimeForStep(int _step)
-{
-	if (_step < m_remainingTimes.size())
-	{
-		return m_remainingTimes[_step];
-	}
-
-	return 0.0;
-}
-
-double Task::GetRemainingTotalTime()
-{
-	double remainingTime = 0.0;
-	for (int i = 0; i < m_remainingTimes.size(); i++)
-	{
-		remainingTime += m_remainingTimes[i];
-	}
-
-	return remainingTime;
-}
-
-bool Task::IsReady()
-{
-	for (Task* father : m_fathers)
-	{
-		if (!father->IsDone())
-		{
-			return false;
-		}
-	}
-
-	return true;
-}
-
-bool Task::IsDone()
-{
-	return std::abs(GetRemainingTotalTime()) < std::numeric_limits<double>::epsilon();
-}
-
-bool Task::HasFreeStepToProcess()
-{
-	return m_iCurrentStep != m_totalSteps;
-}
-
-int Task::ClaimFreeStep()
-{
-	return m_iCurrentStep++;
-}
-
-int Task::GetStepCount()
-{
-	return m_totalSteps;
-}
-
-std::string Task::GetName()
-{
-	return m_name;
-}
-
-std::vector<Task*> Task::GetFathers() 
-{
-    return m_fathers;
-}
-
-std::vector<Task*> Task::GetSons()
-{
-	return m_sons;
-}
-
-std::string Task::GetTaskType()
-{
-	return m_type;
-}
-
-double Task::Get_meanLog()
-{
-	return m_meanLog;
-}
-double Task::ProceesTime()
-{
-	return m_totalSteps*m_meanTime;
-}
-
-double Task::meanTime()
+double Task::meanTime() const
 {
 	return m_mean;
 }
@@ -245,7 +77,7 @@ void Task::AddTopoOrder(int _label)
 	m_TopoOrder = _label;
 }
 
-int Task::GetTopoOrder()
+int Task::GetTopoOrder() const
 {
 	return m_TopoOrder;
 }
@@ -255,28 +87,12 @@ void Task::AddLabel(int _label)
 	m_label = _label;
 }
 
-int Task::GetLabel()
+int Task::GetLabel() const
 {
 	return m_label;
 }
 
-bool const Task::operator==(Task& rhs)
+bool const Task::operator==(const Task& rhs) const
 { 
 	return this->GetName() == rhs.GetName(); 
 }
-
-void Task::WichToAssign(std::string _choice)
-{
-	m_choice = _choice;
-}
-
-double Task::GetRemainingPreviousTime()
-{
-	double ExecutedTimePortion=0.0;
-	for(int i=0;i<m_iCurrentStep;i++)
-	{
-		ExecutedTimePortion+=m_Times[i];
-	}
-	return std::max(0.0,this->GetPT()-ExecutedTimePortion);
-};
-
@@ -10,7 +10,18 @@ void TaskSequence::AddTask(Task* _task)
 {
     if (_task != nullptr)
     {
+        // The index of a task is its position in the sequence; it addresses its state in a simulation
+        if (m_taskMap.find(_task->GetName()) != m_taskMap.end())
+        {
+            _task->AddIndex(m_taskMap[_task->GetName()]->GetIndex());
+        }
+        else
+        {
+            _task->AddIndex(m_taskMap.size());
+        }
         m_taskMap[_task->GetName()] = _task;
+        m_tasks.resize(m_taskMap.size());
+        m_tasks[_task->GetIndex()] = _task;
     }
 }
 
@@ -29,6 +40,16 @@ std::map<std::string, Task*>& TaskSequence::GetTaskMap()
     return m_taskMap;
 }
 
+std::vector<int> TaskSequence::GetIndicesByName() const
+{
+    std::vector<int> indices;
+    for (const auto& elem : m_taskMap)
+    {
+        indices.push_back(elem.second->GetIndex());
+    }
+    return indices;
+}
+
 void TaskSequence::Clear()
 { 
     std::map<std::string, Task*>::iterator it;
@@ -38,6 +59,7 @@ void TaskSequence::Clear()
     }
 
     m_taskMap.clear();
+    m_tasks.clear();
 }
 
 double TaskSequence::graph()
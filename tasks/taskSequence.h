@@ -2,6 +2,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 
 #include "task.h"
 
@@ -16,9 +17,14 @@ public:
     void Clear();
 
     std::map<std::string, Task*>& GetTaskMap();
+    //TASKS BY INDEX
+    const std::vector<Task*>& GetTasks() const { return m_tasks; };
+    //INDICES OF THE TASKS IN NAME ORDER
+    std::vector<int> GetIndicesByName() const;
 	double graph();
 private:
     std::map<std::string, Task*> m_taskMap;
+    std::vector<Task*> m_tasks;
 	double m_graph;
 };
 
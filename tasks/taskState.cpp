@@ -0,0 +1,162 @@
+#include <stdafx.h>
+#include "taskState.h"
+
+TaskState::TaskState(const Task* _task)
+{
+	m_task = _task;
+	Reset();
+}
+
+void TaskState::Reset()
+{
+	// Nothing is known about previous frames before the first frame of a run
+	m_times = nullptr;
+	m_timeCount = 0;
+	m_timeTotals = { 0.0, 0.0, 0 };
+	m_remainingCount = 0;
+	m_workSteps = 0;
+	m_isMedian = false;
+	m_medianTime = 0.0;
+	m_startTotalTime = 0.0;
+	m_startLongestTime = 0.0;
+	m_stepDone.clear();
+	m_frameStamp = 0;
+	m_doneCount = 0;
+	m_doneTime = 0.0;
+	m_claimedTime = 0.0;
+	m_iCurrentStep = 0;
+	m_totalSteps = 0;
+	m_TotalProceesingTime = 0.0;
+	m_FinishTime = 0.0;
+	m_BW = 0.0;
+	m_EW = 0.0;
+	m_LS = 0.0;
+	m_antChoice = 0;
+}
+
+void TaskState::Initialize(double _lagProportion)
+{
+	m_iCurrentStep = 0;
+	
+	m_totalSteps = this->GetStepCount();
+	m_remainingCount = 0;
+	m_workSteps = 0;
+	m_startTotalTime = 0.0;
+	m_startLongestTime = 0.0;
+	
+	if (m_choice == "Random")
+	{
+		m_isMedian = false;
+		m_remainingCount = m_timeCount;
+		m_workSteps = m_timeTotals.m_workSteps;
+		m_startTotalTime = m_timeTotals.m_sum;
+		m_startLongestTime = m_timeTotals.m_longest;
+	}
+	if (m_choice == "Median")
+	{
+		AssignMediane(_lagProportion);
+	}
+
+	m_frameStamp++;
+	m_doneCount = 0;
+	m_doneTime = 0.0;
+	m_claimedTime = 0.0;
+	if ((int)m_stepDone.size() < m_remainingCount)
+	{
+		m_stepDone.resize(m_remainingCount, 0);
+	}
+}
+
+void TaskState::PushInTime(const double* _times, int _count, const TimeTotals& _totals)
+{
+	m_times = _times;
+	m_timeCount = _count;
+	m_timeTotals = _totals;
+};
+
+
+void TaskState::AssignMediane(double _lagProportion)
+{
+	m_isMedian = true;
+	m_remainingCount = m_totalSteps;
+	m_medianTime = (1 - _lagProportion) * m_task->GetMean() + _lagProportion * m_task->GetMeanLag();
+	// Added step after step, as the remaining times are
+	m_startTotalTime = 0.0;
+	for (int i = 0; i < m_remainingCount; i++)
+	{
+		m_startTotalTime += m_medianTime;
+	}
+	m_startLongestTime = (m_remainingCount > 0) ? std::max(0.0, m_medianTime) : 0.0;
+	m_workSteps = (m_medianTime > 0.0) ? m_remainingCount : 0;
+}
+
+void TaskState::UpdateStepCount(int _nb)
+{ 
+	m_totalSteps = _nb; 
+}
+
+bool TaskState::Execute(int _step)
+{
+	if (_step >= m_remainingCount || m_stepDone[_step] == m_frameStamp)
+	{
+		return false;
+	}
+	double time = GetRemainingTimeForStep(_step);
+	m_stepDone[_step] = m_frameStamp;
+	if (time <= 0.0)
+	{
+		return false;
+	}
+	m_doneTime += time;
+	m_doneCount++;
+	return IsDone();
+}
+
+double TaskState::GetRemainingTimeForStep(int _step)
+{
+	if (_step < m_remainingCount && m_stepDone[_step] != m_frameStamp)
+	{
+		return m_isMedian ? m_medianTime : m_times[_step];
+	}
+
+	return 0.0;
+}
+
+double TaskState::GetRemainingTotalTime()
+{
+	return IsDone() ? 0.0 : std::max(0.0, m_startTotalTime - m_doneTime);
+}
+
+bool TaskState::IsDone()
+{
+	return m_doneCount == m_workSteps;
+}
+
+bool TaskState::HasFreeStepToProcess()
+{
+	return m_iCurrentStep != m_totalSteps;
+}
+
+int TaskState::ClaimFreeStep()
+{
+	if (m_iCurrentStep < m_timeCount)
+	{
+		m_claimedTime += m_times[m_iCurrentStep];
+	}
+	return m_iCurrentStep++;
+}
+
+int TaskState::GetStepCount()
+{
+	return m_totalSteps;
+}
+
+void TaskState::WichToAssign(std::string _choice)
+{
+	m_choice = _choice;
+}
+
+double TaskState::GetRemainingPreviousTime()
+{
+	return std::max(0.0,this->GetPT()-m_claimedTime);
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "task.h"
+
+// State of a task during one simulation: execution times of the current frame, progress of its
+// steps and the values kept from the previous frame for the scheduling strategies.
+class TaskState
+{
+
+public:
+	TaskState(const Task* _task);
+
+	//BACK TO THE STATE BEFORE THE FIRST FRAME
+	void Reset();
+
+	const Task* GetTask() { return m_task; };
+
+	void Initialize(double _lagProportion);
+	void AssignMediane(double _lagProportion);
+
+	//END A STEP: RETURNS TRUE WHEN IT WAS THE LAST UNFINISHED STEP OF THE TASK
+	bool Execute(int _step);
+	double GetRemainingTimeForStep(int _step);
+	double GetRemainingTotalTime();
+	//DONE WHEN ALL ITS STEPS WITH SOME TIME TO SPEND ARE DONE
+	bool IsDone();
+
+	bool HasFreeStepToProcess();
+	int ClaimFreeStep();
+	int GetStepCount();
+	int GetCurrentStep() { return m_iCurrentStep; };
+
+	//UPDATE THE NUMBER OF STEPS FOR EACH FRAME
+	void UpdateStepCount(int _nb);
+
+	//ADD MODE TO WORK WORK: RANDOM OR MEDIAN
+	void WichToAssign(std::string);
+
+	//ASSIGN STOCKED EXECUTION TIMES TO THE TASK: THE TIMES ARE READ IN PLACE, NOT COPIED,
+	//AND MUST STAY AVAILABLE UNTIL THE END OF THE FRAME
+	void PushInTime(const double* _times, int _count, const TimeTotals& _totals);
+	const double* GetTimes() { return m_times; };
+	int GetTimeCount() { return m_timeCount; };
+
+	//SUM AND LONGEST OF THE TIMES OF THE STEPS WHEN THE FRAME STARTS, IN THE ASSIGNED MODE
+	double GetStartTotalTime() { return m_startTotalTime; };
+	double GetStartLongestTime() { return m_startLongestTime; };
+
+	//ADD AND GET THE PROCESSING TIME FOR A TASK: USED FOR LPT AND SPT ALGORITHMS
+	void AddPT(double _PT) { m_TotalProceesingTime = _PT; }
+	double GetPT() { return m_TotalProceesingTime; };
+
+	//ADD AND GET THE FINISHING TIME OF THE TASK IN THE PREVIOUS FRAME
+	void AddFT(double _FT) { m_FinishTime = _FT; }
+	double GetFT() { return m_FinishTime; };
+	
+	//ADD AND GET THE BEGINING OF THE WAITING TIME OF THE TASK IN THE PREVIOUS FRAME
+	void AddBW(double _FT) { m_BW = _FT; }
+	double GetBW() { return m_BW; };
+
+	//ADD AND GET THE BEGINING TIME OF THE EXECUTION OF THE TASK IN THE PREVIOUS FRAME
+	void AddEW(double _FT) { m_EW = _FT; }
+	double GetEW() { return m_EW; };
+
+	//GET THE RATIO RESPONSE TIME: USED FOR HRRN ALGORITHM
+	double GetResponseRatio() { return (m_FinishTime- m_BW)/ (m_FinishTime - m_EW); };
+
+	//GET THE WAITING TIME OF THE TASK IN THE PREVIOUS FRAME
+	double GetWaitingTime(){return m_EW-m_BW;};
+
+	//ADD AND GET THE LONGEST PROCESSING TIME OF TASK'S STEP
+	void AddLS(double _LS) { m_LS = _LS; }
+	double GetLS() { return m_LS; };
+
+	//ADD AND GET ANT SCHEDULING
+	void AddAnt(int _antChoice) { m_antChoice= _antChoice; }
+	int GetAnt() { return m_antChoice; };
+
+	//GET THE REMAINING TIME FOR THE TASK BASED IN THE PREVIOUS EXECUTION TIME
+	double GetRemainingPreviousTime();
+
+private:
+	const Task* m_task;
+	const double* m_times;
+	int m_timeCount;
+	TimeTotals m_timeTotals;
+
+	//STEPS WITH A TIME TO SPEND THIS FRAME, ALL THE SAME TIME IN MEDIAN MODE
+	int m_remainingCount;
+	int m_workSteps;
+	bool m_isMedian;
+	double m_medianTime;
+	double m_startTotalTime;
+	double m_startLongestTime;
+
+	//A STEP IS DONE WHEN ITS STAMP IS THE STAMP OF THE FRAME: NOTHING TO CLEAR BETWEEN FRAMES
+	std::vector<int> m_stepDone;
+	int m_frameStamp;
+
+	//KEPT UP TO DATE WHEN A STEP IS CLAIMED OR DONE: NO LOOP OVER THE STEPS TO KNOW THE PROGRESS
+	int m_doneCount;
+	double m_doneTime;
+	double m_claimedTime;
+	int m_iCurrentStep;
+	int m_totalSteps;
+	std::string m_choice;
+	double m_TotalProceesingTime;
+	double m_FinishTime;
+	double m_BW;
+	double m_EW;
+	double m_LS;
+	int m_antChoice;
+};
@@ -6,65 +6,65 @@ Worker::Worker(int _id)
 {
     m_id = _id;
     m_currentTask = nullptr;
-    m_currentCoreTime = 0.0;
+    m_finishTime = 0.0;
     m_currentTaskStep = 0;
 	m_load = 0.0;
 }
 
-double Worker::Execute()
+// End the current step, at its finish time
+void Worker::Execute(Scheduler* _scheduler)
 {
-    double timeSpent = 0.0;
     if (m_currentTask != nullptr)
     {
-        timeSpent = m_currentTask->GetRemainingTimeForStep(m_currentTaskStep);
         if (m_currentTask->GetStepCount() == m_currentTaskStep+1)
 		{
-			m_currentTask->AddFT(m_currentCoreTime + timeSpent);
+			m_currentTask->AddFT(m_finishTime);
 		}
         if(outside)
-            Profiler::GetInstance()->AddKeyFrame(m_id, m_currentTask->GetName(), "GenericTask", m_currentCoreTime + timeSpent, Profiler::KEY_EVENT_TYPE::END, m_currentTaskStep, m_currentTask->GetStepCount());
-        m_currentTask->Execute(m_currentTaskStep);
+            Profiler::GetInstance()->AddKeyFrame(m_id, m_currentTask->GetTask()->GetName(), "GenericTask", m_finishTime, Profiler::KEY_EVENT_TYPE::END, m_currentTaskStep, m_currentTask->GetStepCount());
+        if (m_currentTask->Execute(m_currentTaskStep))
+        {
+            _scheduler->OnTaskDone(m_currentTask);
+        }
         
         m_currentTask = nullptr;
     }
-
-    return timeSpent;
 }
 
-void Worker::UpdateTime(double _timeSpent)
+// A step that ends by _clockTime has no remaining time, even if the worker is not released yet
+void Worker::UpdateTime(Scheduler* _scheduler, double _clockTime)
 {
-    m_currentCoreTime += _timeSpent;
-    if (m_currentTask != nullptr)
+    if (m_currentTask != nullptr && m_finishTime <= _clockTime)
     {
-        m_currentTask->SpendTime(m_currentTaskStep, _timeSpent);
+        if (m_currentTask->Execute(m_currentTaskStep))
+        {
+            _scheduler->OnTaskDone(m_currentTask);
+        }
     }
 }
 
-void Worker::FetchNewTaskIfAvailable(Scheduler* _scheduler)
+bool Worker::FetchNewTaskIfAvailable(Scheduler* _scheduler, double _clockTime)
 {
     if (m_currentTask == nullptr)
     {
         m_currentTask = _scheduler->GetNextAvailableTask(m_id, m_currentTaskStep);
         if (m_currentTask != nullptr)
 		{
+			m_finishTime = _clockTime + m_currentTask->GetRemainingTimeForStep(m_currentTaskStep);
 			if (m_currentTask->GetCurrentStep() == 1)
 			{
-				m_currentTask->AddEW(m_currentCoreTime);
+				m_currentTask->AddEW(_clockTime);
 			}
 		}
         if (m_currentTask != nullptr&&outside)
         {
-            Profiler::GetInstance()->AddKeyFrame(m_id, m_currentTask->GetName(), "GenericTask", m_currentCoreTime, Profiler::KEY_EVENT_TYPE::BEGIN, m_currentTaskStep, m_currentTask->GetStepCount());
+            Profiler::GetInstance()->AddKeyFrame(m_id, m_currentTask->GetTask()->GetName(), "GenericTask", _clockTime, Profiler::KEY_EVENT_TYPE::BEGIN, m_currentTaskStep, m_currentTask->GetStepCount());
         }
     }
+    return m_currentTask != nullptr;
 }
 
 bool Worker::IsProcessingTask()
 {
     return m_currentTask != nullptr;
 }
-
-double Worker::GetRemainingTime()
-{
-    return (m_currentTask != nullptr ? m_currentTask->GetRemainingTimeForStep(m_currentTaskStep) : 0.0);
-}
\ No newline at end of file
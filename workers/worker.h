@@ -1,6 +1,6 @@
 #pragma once
 
-#include "../tasks/task.h"
+#include "../tasks/taskState.h"
 #include "../scheduler/scheduler.h"
 #include "../tasks/keytasks.h"
 
@@ -10,26 +10,23 @@ class Worker
 public:
     Worker(int _id);
 
-    double Execute();
-    void UpdateTime(double _timeSpent);
-    void FetchNewTaskIfAvailable(Scheduler* _scheduler);
+    void Execute(Scheduler* _scheduler);
+    void UpdateTime(Scheduler* _scheduler, double _clockTime);
+    bool FetchNewTaskIfAvailable(Scheduler* _scheduler, double _clockTime);
 
     bool IsProcessingTask();
-    double GetRemainingTime();
+    TaskState* GetCurrentTask() { return m_currentTask; };
+    double GetFinishTime() { return m_finishTime; };
 	void AddLoad(double _load) { m_load += _load; };
 	double GetLoad() { return m_load; };
-    double GetcurrentcoreTime() { return m_currentCoreTime; };
     bool outside;
-    bool FirstPhase(){return (m_currentTask!=nullptr)?(m_currentTask->GetName()==P_TASK):false;};
-    bool SecondPhase(){return (m_currentTask!=nullptr)?(m_currentTask->GetName()==S_TASK):false;};
 
 private:
-    Task* m_currentTask;
+    TaskState* m_currentTask;
     int m_currentTaskStep;
 
     int m_id;
-    double m_currentCoreTime;
+    double m_finishTime; // absolute time at which the current step ends
 	double m_load;
     
 };
-